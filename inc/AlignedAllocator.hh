@@ -0,0 +1,145 @@
+#ifndef ZAD3_ALIGNEDALLOCATOR_HH
+#define ZAD3_ALIGNEDALLOCATOR_HH
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+/**
+ * Zwraca zasob pamieci, z ktorego alokuja alokatory tworzone na biezacym watku (nullptr - sterta);
+ * ustawiany przez AllocationScope
+ * @return referencja na wskaznik zasobu
+ */
+inline std::pmr::memory_resource*& scoped_resource() {
+    static thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+/**
+ * Ustawia zasob pamieci biezacego watku na czas zycia obiektu (np. Arena albo
+ * std::pmr::unsynchronized_pool_resource), przywracajac potem poprzedni
+ */
+class AllocationScope {
+public:
+    /**
+     * Ustawia zasob
+     * @param resource zasob pamieci (nullptr - sterta)
+     */
+    explicit AllocationScope(std::pmr::memory_resource* resource) : previous(scoped_resource()) {
+        scoped_resource() = resource;
+    }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    /**
+     * Przywraca poprzedni zasob
+     */
+    ~AllocationScope() {
+        scoped_resource() = previous;
+    }
+
+private:
+    std::pmr::memory_resource* previous; /** Zasob sprzed utworzenia obiektu */
+};
+
+/* kontener pamieta zasob, z ktorego zaalokowal pamiec, i nie przejmuje go przy przypisaniu, wiec obiekt
+ * utworzony poza AllocationScope nigdy nie trafia do areny; kopia alokuje z zasobu biezacego watku.
+ * Obiekty z pamiecia w arenie musza zostac zniszczone przed jej wyczyszczeniem */
+
+/**
+ * Alokator zwracajacy pamiec wyrownana do podanej granicy (domyslnie linii cache), ze sterty lub
+ * z zasobu pamieci ustawionego przez AllocationScope w chwili utworzenia alokatora
+ * @tparam T
+ * @tparam alignment
+ */
+template <class T, size_t alignment = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    /**
+     * Pozwala kontenerom uzyskac alokator dla innego typu
+     * @tparam U
+     */
+    template <class U>
+    struct rebind {
+        using other = AlignedAllocator<U, alignment>;
+    };
+
+    /**
+     * Tworzy alokator korzystajacy z zasobu pamieci biezacego watku
+     */
+    AlignedAllocator() noexcept : memory(scoped_resource()) {}
+
+    /**
+     * Tworzy alokator korzystajacy z podanego zasobu pamieci
+     * @param resource zasob pamieci (nullptr - sterta)
+     */
+    explicit AlignedAllocator(std::pmr::memory_resource* resource) noexcept : memory(resource) {}
+
+    /**
+     * Tworzy alokator z alokatora innego typu
+     */
+    template <class U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, alignment>& other) noexcept : memory(other.resource()) {}
+
+    /**
+     * Zwraca zasob pamieci alokatora
+     * @return zasob (nullptr - sterta)
+     */
+    std::pmr::memory_resource* resource() const noexcept {
+        return memory;
+    }
+
+    /**
+     * Alokator dla kopii kontenera: kopia alokuje z zasobu biezacego watku
+     * @return alokator
+     */
+    AlignedAllocator select_on_container_copy_construction() const noexcept {
+        return AlignedAllocator();
+    }
+
+    /**
+     * Alokuje pamiec na n obiektow
+     * @param n
+     * @return wskaznik na wyrownana pamiec
+     */
+    T* allocate(size_t n) {
+        if (memory != nullptr)
+            return static_cast<T*>(memory->allocate(n * sizeof(T), alignment));
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    /**
+     * Zwalnia pamiec
+     * @param pointer
+     * @param n
+     */
+    void deallocate(T* pointer, size_t n) noexcept {
+        if (memory != nullptr)
+            memory->deallocate(pointer, n * sizeof(T), alignment);
+        else
+            ::operator delete(pointer, std::align_val_t(alignment));
+    }
+
+private:
+    std::pmr::memory_resource* memory; /** Zasob pamieci (nullptr - sterta) */
+};
+
+template <class T, class U, size_t alignment>
+bool operator==(const AlignedAllocator<T, alignment>& a, const AlignedAllocator<U, alignment>& b) {
+    return a.resource() == b.resource();
+}
+
+template <class T, class U, size_t alignment>
+bool operator!=(const AlignedAllocator<T, alignment>& a, const AlignedAllocator<U, alignment>& b) {
+    return !(a == b);
+}
+
+#endif //ZAD3_ALIGNEDALLOCATOR_HH
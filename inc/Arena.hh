@@ -0,0 +1,84 @@
+#ifndef ZAD3_ARENA_HH
+#define ZAD3_ARENA_HH
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/**
+ * Arena pamieci: alokacja to przesuniecie wskaznika w biezacym fragmencie, zwalnianie pojedynczych
+ * obiektow nic nie robi, a reset() zwalnia wszystko naraz, zachowujac pamiec na kolejne alokacje.
+ * Fragmenty po resecie sa laczone w jeden, wiec powtarzalna praca (np. kolejne okna ukladow) po
+ * pierwszym przebiegu nie alokuje juz ze sterty. Alokacja jest bezpieczna wielowatkowo, reset nie
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t default_chunk_size = 1 << 20; /** Domyslny rozmiar pierwszego fragmentu */
+
+    /**
+     * Tworzy pusta arene
+     * @param chunk_size rozmiar pierwszego fragmentu, kolejne sa dwa razy wieksze od poprzedniego
+     */
+    explicit Arena(size_t chunk_size = default_chunk_size);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Zwalnia wszystkie obiekty naraz; zadna alokacja nie moze trwac rownoczesnie
+     */
+    void reset();
+
+    /**
+     * Zwraca liczbe alokacji od ostatniego resetu
+     * @return liczba alokacji
+     */
+    size_t allocations() const;
+
+    /**
+     * Zwraca liczbe zaalokowanych bajtow od ostatniego resetu (z wyrownaniem)
+     * @return liczba bajtow
+     */
+    size_t used() const;
+
+    /**
+     * Zwraca laczny rozmiar fragmentow
+     * @return liczba bajtow
+     */
+    size_t capacity() const;
+
+private:
+    /**
+     * Ciagly fragment pamieci
+     */
+    struct Chunk {
+        std::unique_ptr<char[]> data; /** Pamiec wyrownana do alignment */
+        char* begin; /** Poczatek wyrownanej pamieci */
+        size_t size; /** Rozmiar */
+        std::atomic<size_t> used{0}; /** Przesuniecie wolnej pamieci (po przepelnieniu moze przekraczac size) */
+    };
+
+    static constexpr size_t alignment = 64; /** Wyrownanie kazdego obiektu */
+
+    std::vector<std::unique_ptr<Chunk>> chunks; /** Fragmenty, ostatni jest biezacy */
+    std::atomic<Chunk*> current{nullptr}; /** Biezacy fragment */
+    std::mutex growth; /** Chroni dodawanie fragmentow */
+    std::atomic<size_t> count{0}; /** Liczba alokacji */
+    size_t next_size; /** Rozmiar kolejnego fragmentu */
+
+    /**
+     * Dodaje fragment mieszczacy co najmniej bytes bajtow, jesli biezacym jest wciaz seen
+     * @param seen
+     * @param bytes
+     */
+    void grow(const Chunk* seen, size_t bytes);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif //ZAD3_ARENA_HH
@@ -0,0 +1,141 @@
+#ifndef ZAD3_BATCHSOLVER_HH
+#define ZAD3_BATCHSOLVER_HH
+
+#include <exception>
+#include <vector>
+
+#include "../inc/LinearEquation.hh"
+#include "../inc/BatchedLinearEquation.hh"
+#include "../inc/ThreadPool.hh"
+
+/* uklady sa niezalezne, wiec dzielone sa na przedzialy rozwiazywane przez watki puli; kazdy uklad
+ * zapisuje wynik we wlasnych atrybutach, wiec kolejnosc wynikow nie zalezy od przydzialu do watkow */
+
+/**
+ * Rozwiazuje rownania equations[0], ..., equations[count - 1] metoda solve() na watkach puli;
+ * pierwszy wyjatek (np. macierz osobliwa) jest rzucany po zakonczeniu wszystkich przedzialow
+ * @param equations
+ * @param count
+ * @param pool
+ * @param grain liczba rownan w jednym zadaniu (0 - dobrana automatycznie)
+ */
+template <class E>
+void solve_batch(E* equations, const size_t count, ThreadPool& pool, const size_t grain = 0) {
+    pool.parallel_for(count, grain, [equations](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++)
+            equations[i].solve();
+    });
+}
+
+/**
+ * @see solve_batch
+ * @param equations
+ * @param pool
+ * @param grain
+ */
+template <class E>
+void solve_batch(std::vector<E>& equations, ThreadPool& pool, const size_t grain = 0) {
+    solve_batch(equations.data(), equations.size(), pool, grain);
+}
+
+/**
+ * Rozwiazuje rownania z pary tablic macierzy i wektorow wyrazow wolnych, zapisujac rozwiazania
+ * do tablicy wynikowej (uklad i-ty: matrices[i] * results[i] = vectors[i])
+ * @param matrices
+ * @param vectors
+ * @param results
+ * @param count
+ * @param pool
+ * @param grain
+ */
+template <class T, size_t size>
+void solve_batch(const Matrix<T, size>* matrices, const Vector<T, size>* vectors, Vector<T, size>* results,
+                 const size_t count, ThreadPool& pool, const size_t grain = 0) {
+    pool.parallel_for(count, grain, [=](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++)
+            results[i] = LUDecomposition<T, size>(matrices[i]).solve(vectors[i]);
+    });
+}
+
+/**
+ * Rozwiazuje rownania *equations[0], ..., *equations[count - 1]: rownania o rozmiarze do lane_solver_limit
+ * grupowane sa wedlug rozmiaru i rozwiazywane przez BatchedLinearEquation po kilka naraz, wieksze metoda
+ * solve(); bez tablicy failed pierwszy wyjatek (np. macierz osobliwa) jest rzucany po rozwiazaniu wszystkich
+ * pozostalych rownan, a z nia kazde rownanie dostaje wlasny znacznik i nic nie jest rzucane
+ * @tparam T
+ * @param equations
+ * @param count
+ * @param failed tablica count znacznikow rownan nierozwiazanych (np. macierz osobliwa) albo nullptr
+ */
+template <class T>
+void solve_lanes(DynamicLinearEquation<T>* const* equations, const size_t count, bool* const failed = nullptr) {
+    std::vector<DynamicLinearEquation<T>*> groups[lane_solver_limit + 1];
+    std::vector<size_t> indices[lane_solver_limit + 1];
+    std::exception_ptr failure;
+
+    for (size_t i = 0; i < count; i++) {
+        if (failed)
+            failed[i] = false;
+        const size_t n = equations[i]->size();
+        if (n > 0 && n <= lane_solver_limit && equations[i]->factor_matrix.columns() == n && equations[i]->result_vector.length() == n) {
+            groups[n].push_back(equations[i]);
+            indices[n].push_back(i);
+            continue;
+        }
+        try {
+            equations[i]->solve();
+        } catch (...) {
+            if (failed)
+                failed[i] = true;
+            else if (!failure)
+                failure = std::current_exception();
+        }
+    }
+
+    for (size_t n = 1; n <= lane_solver_limit; n++) {
+        const std::vector<DynamicLinearEquation<T>*>& group = groups[n];
+        if (group.empty())
+            continue;
+
+        BatchedLinearEquation<T> batch(n, group.size());
+        for (size_t i = 0; i < group.size(); i++)
+            batch.set(i, group[i]->factor_matrix, group[i]->result_vector);
+        try {
+            batch.solve();
+        } catch (...) {
+            if (!failed && !failure)
+                failure = std::current_exception();
+        }
+
+        for (size_t i = 0; i < group.size(); i++) {
+            if (batch.singular(i)) {
+                if (failed)
+                    failed[indices[n][i]] = true;
+                continue;
+            }
+            batch.unknown_vector(i, group[i]->unknown_vector);
+            batch.error_vector(i, group[i]->error_vector);
+        }
+    }
+
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+/**
+ * @see solve_lanes, kolejne przedzialy rownan rozwiazywane na watkach puli
+ * @param equations
+ * @param count
+ * @param pool
+ * @param grain
+ * @param failed
+ */
+template <class T>
+void solve_lanes(DynamicLinearEquation<T>* const* equations, const size_t count, ThreadPool& pool, const size_t grain = 0,
+                 bool* const failed = nullptr) {
+    pool.parallel_for(count, grain, [equations, failed](const size_t begin, const size_t end) {
+        solve_lanes(equations + begin, end - begin, failed ? failed + begin : nullptr);
+    });
+}
+
+#endif //ZAD3_BATCHSOLVER_HH
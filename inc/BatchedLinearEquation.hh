@@ -0,0 +1,283 @@
+#ifndef ZAD3_BATCHEDLINEAREQUATION_HH
+#define ZAD3_BATCHEDLINEAREQUATION_HH
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Scalar.hh"
+#include "../inc/Kernels.hh"
+#include "../inc/AlignedAllocator.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/Instrumentation.hh"
+
+/* uklady zapisane sa naprzemiennie w blokach po lanes ukladow: skalar (x, y) ukladu l bloku lezy pod
+ * indeksem (x * (n + 1) + y) * lanes + l, wiec ten sam skalar kolejnych ukladow tworzy jeden wektor SIMD
+ * i eliminacja (Kernels::lane_solve) rozwiazuje caly blok naraz, po jednym ukladzie na skladowa, a wektory
+ * bledu wylicza osobne jadro (Kernels::lane_residual) */
+
+/**
+ * Wiele ukladow rownan o tym samym rozmiarze n <= lane_solver_limit rozwiazywanych blokami po
+ * Kernels::lanes ukladow (8 dla double i Complex<double>); liczby zespolone zapisane sa w osobnych
+ * tablicach czesci rzeczywistych i urojonych
+ * @tparam T
+ */
+template <class T>
+class BatchedLinearEquation {
+    using R = typename Scalar<T>::real_type;
+    using Storage = std::vector<R, AlignedAllocator<R>>;
+
+public:
+    static constexpr size_t lanes = Kernels<R>::lanes; /** Liczba ukladow w bloku */
+
+    /**
+     * Tworzy count ukladow o rozmiarze size, poczatkowo z macierza jednostkowa i zerowym wektorem
+     * wyrazow wolnych
+     * @param size
+     * @param count
+     */
+    BatchedLinearEquation(size_t size, size_t count);
+
+    /**
+     * Zwraca liczbe niewiadomych kazdego ukladu
+     * @return rozmiar
+     */
+    size_t size() const;
+
+    /**
+     * Zwraca liczbe ukladow
+     * @return liczba ukladow
+     */
+    size_t count() const;
+
+    /**
+     * Zapisuje i-ty uklad
+     * @param i
+     * @param matrix macierz wspolczynnikow size x size
+     * @param vector wektor wyrazow wolnych
+     */
+    void set(size_t i, const DynamicMatrix<T>& matrix, const DynamicVector<T>& vector);
+
+    /**
+     * Rozwiazuje wszystkie uklady i wylicza ich wektory bledu Ax-b; gdy ktorys uklad jest osobliwy,
+     * po rozwiazaniu pozostalych rzuca wyjatek, a rozwiazania ukladow nieosobliwych pozostaja poprawne
+     */
+    void solve();
+
+    /**
+     * Sprawdza, czy i-ty uklad okazal sie osobliwy w ostatnim solve()
+     * @param i
+     * @return true dla ukladu osobliwego
+     */
+    bool singular(size_t i) const;
+
+    /**
+     * Zapisuje rozwiazanie i-tego ukladu do wektora (wektor o dlugosci size jest zapisywany bez ponownej alokacji)
+     * @param i
+     * @param result
+     */
+    void unknown_vector(size_t i, DynamicVector<T>& result) const;
+
+    /**
+     * Zapisuje wektor bledu Ax-b i-tego ukladu do wektora
+     * @param i
+     * @param result
+     */
+    void error_vector(size_t i, DynamicVector<T>& result) const;
+
+    /**
+     * @see unknown_vector(size_t, DynamicVector<T>&)
+     * @return rozwiazanie
+     */
+    DynamicVector<T> unknown_vector(size_t i) const;
+
+    /**
+     * @see error_vector(size_t, DynamicVector<T>&)
+     * @return wektor bledu
+     */
+    DynamicVector<T> error_vector(size_t i) const;
+
+private:
+    size_t n; /** Rozmiar ukladow */
+    size_t systems; /** Liczba ukladow */
+
+    Storage system_real, system_imaginary; /** Macierze z dopisanym wektorem wyrazow wolnych */
+    Storage unknown_real, unknown_imaginary; /** Rozwiazania */
+    Storage error_real, error_imaginary; /** Wektory bledu */
+    std::vector<unsigned> singular_lanes; /** Maski ukladow osobliwych kazdego bloku */
+
+    /**
+     * Zapisuje wektor ukladu i z tablic wektorow zapisanych naprzemiennie
+     * @param i
+     * @param real
+     * @param imaginary
+     * @param result
+     */
+    void gather(size_t i, const Storage& real, const Storage& imaginary, DynamicVector<T>& result) const;
+};
+
+template <class T>
+BatchedLinearEquation<T>::BatchedLinearEquation(const size_t size, const size_t count) : n(size), systems(count) {
+    if (size == 0 || size > lane_solver_limit)
+        throw std::runtime_error("Size out of range");
+
+    const size_t blocks = (count + lanes - 1) / lanes;
+    system_real.assign(blocks * n * (n + 1) * lanes, R(0));
+    unknown_real.assign(blocks * n * lanes, R(0));
+    error_real.assign(blocks * n * lanes, R(0));
+    if constexpr (Scalar<T>::complex) {
+        system_imaginary.assign(system_real.size(), R(0));
+        unknown_imaginary.assign(unknown_real.size(), R(0));
+        error_imaginary.assign(error_real.size(), R(0));
+    }
+    singular_lanes.assign(blocks, 0);
+
+    /* niewykorzystane skladowe ostatniego bloku zostaja ukladami jednostkowymi, nigdy osobliwymi */
+    for (size_t block = 0; block < blocks; block++)
+        for (size_t x = 0; x < n; x++)
+            for (size_t l = 0; l < lanes; l++)
+                system_real[((block * n + x) * (n + 1) + x) * lanes + l] = R(1);
+}
+
+template <class T>
+size_t BatchedLinearEquation<T>::size() const {
+    return n;
+}
+
+template <class T>
+size_t BatchedLinearEquation<T>::count() const {
+    return systems;
+}
+
+template <class T>
+void BatchedLinearEquation<T>::set(const size_t i, const DynamicMatrix<T>& matrix, const DynamicVector<T>& vector) {
+    if (i >= systems)
+        throw std::runtime_error("Index out of range");
+    if (matrix.rows() != n || matrix.columns() != n || vector.length() != n)
+        throw std::runtime_error("Size mismatch");
+
+    const size_t offset = i / lanes * n * (n + 1) * lanes + i % lanes;
+    for (size_t x = 0; x < n; x++) {
+        for (size_t y = 0; y <= n; y++) {
+            const T& value = y < n ? matrix[x][y] : vector[x];
+            const size_t index = offset + (x * (n + 1) + y) * lanes;
+            if constexpr (Scalar<T>::complex) {
+                system_real[index] = value.real;
+                system_imaginary[index] = value.imaginary;
+            } else {
+                system_real[index] = value;
+            }
+        }
+    }
+}
+
+template <class T>
+void BatchedLinearEquation<T>::solve() {
+    const size_t system_stride = n * (n + 1) * lanes;
+    const size_t vector_stride = n * lanes;
+    bool any = false;
+
+    /* podstawianie wstecz odbywa sie w rejestrach jadra razem z eliminacja, wiec jest mierzone jako czesc rozkladu */
+    {
+        ZAD3_PHASE(Phase::factorization, systems * (Cost<T>::factorization(n) + Cost<T>::product(n)),
+                   systems * n * (n + 1) * sizeof(T));
+#ifdef ZAD3_INSTRUMENTATION
+        R buffer[(lane_solver_limit + 1) * lanes];
+        R* const pivots = buffer;
+#else
+        R* const pivots = nullptr;
+#endif
+
+        for (size_t block = 0; block < singular_lanes.size(); block++) {
+            const size_t s = block * system_stride, v = block * vector_stride;
+            if constexpr (Scalar<T>::complex)
+                singular_lanes[block] = Kernels<R>::complex_lane_solve(&system_real[s], &system_imaginary[s], n,
+                                                                       &unknown_real[v], &unknown_imaginary[v], pivots);
+            else
+                singular_lanes[block] = Kernels<R>::lane_solve(&system_real[s], n, &unknown_real[v], pivots);
+            any |= singular_lanes[block] != 0;
+
+#ifdef ZAD3_INSTRUMENTATION
+            /* elementy glowne ukladow bloku, bez osobliwych (jak w rozkladzie LU) i bez ukladow dopelniajacych blok */
+            for (size_t l = 0; l < lanes && block * lanes + l < systems; l++) {
+                if ((singular_lanes[block] >> l) & 1)
+                    continue;
+                double smallest = pivots[l], largest = pivots[l];
+                for (size_t k = 1; k < n; k++) {
+                    smallest = pivots[k * lanes + l] < smallest ? pivots[k * lanes + l] : smallest;
+                    largest = pivots[k * lanes + l] > largest ? pivots[k * lanes + l] : largest;
+                }
+                Instrumentation::record_pivots(smallest, largest, n, static_cast<uint64_t>(pivots[n * lanes + l]));
+            }
+#endif
+        }
+    }
+
+    {
+        ZAD3_PHASE(Phase::residual, systems * Cost<T>::product(n), systems * n * (n + 1) * sizeof(T));
+        for (size_t block = 0; block < singular_lanes.size(); block++) {
+            const size_t s = block * system_stride, v = block * vector_stride;
+            if constexpr (Scalar<T>::complex)
+                Kernels<R>::complex_lane_residual(&system_real[s], &system_imaginary[s], n, &unknown_real[v], &unknown_imaginary[v],
+                                                  &error_real[v], &error_imaginary[v]);
+            else
+                Kernels<R>::lane_residual(&system_real[s], n, &unknown_real[v], &error_real[v]);
+        }
+    }
+
+    if (any)
+        throw std::runtime_error("Singular matrix");
+}
+
+template <class T>
+bool BatchedLinearEquation<T>::singular(const size_t i) const {
+    if (i >= systems)
+        throw std::runtime_error("Index out of range");
+    return (singular_lanes[i / lanes] >> (i % lanes)) & 1;
+}
+
+template <class T>
+void BatchedLinearEquation<T>::gather(const size_t i, const Storage& real, const Storage& imaginary, DynamicVector<T>& result) const {
+    if (i >= systems)
+        throw std::runtime_error("Index out of range");
+    if (result.length() != n)
+        result = DynamicVector<T>(n);
+
+    const size_t offset = i / lanes * n * lanes + i % lanes;
+    for (size_t x = 0; x < n; x++) {
+        if constexpr (Scalar<T>::complex)
+            result[x] = T(real[offset + x * lanes], imaginary[offset + x * lanes]);
+        else
+            result[x] = real[offset + x * lanes];
+    }
+}
+
+template <class T>
+void BatchedLinearEquation<T>::unknown_vector(const size_t i, DynamicVector<T>& result) const {
+    gather(i, unknown_real, unknown_imaginary, result);
+}
+
+template <class T>
+void BatchedLinearEquation<T>::error_vector(const size_t i, DynamicVector<T>& result) const {
+    gather(i, error_real, error_imaginary, result);
+}
+
+template <class T>
+DynamicVector<T> BatchedLinearEquation<T>::unknown_vector(const size_t i) const {
+    DynamicVector<T> result;
+    unknown_vector(i, result);
+    return result;
+}
+
+template <class T>
+DynamicVector<T> BatchedLinearEquation<T>::error_vector(const size_t i) const {
+    DynamicVector<T> result;
+    error_vector(i, result);
+    return result;
+}
+
+using BatchedLinearEquationd = BatchedLinearEquation<double>; /** Alias dla ukladow liczb rzeczywistych */
+using BatchedLinearEquationc = BatchedLinearEquation<Complex<double>>; /** Alias dla ukladow liczb zespolonych */
+
+#endif //ZAD3_BATCHEDLINEAREQUATION_HH
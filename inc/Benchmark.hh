@@ -0,0 +1,163 @@
+#ifndef ZAD3_BENCHMARK_HH
+#define ZAD3_BENCHMARK_HH
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Zapobiega usunieciu przez kompilator obliczenia, ktorego wynik nie jest dalej uzywany
+ * @tparam T
+ * @param value
+ */
+template <class T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * Statystyki czasu jednego pomiaru, w nanosekundach na wywolanie
+ */
+struct BenchmarkStatistics {
+    double min = 0; /** Najkrotsza probka */
+    double median = 0; /** Mediana probek */
+    double mean = 0; /** Srednia probek */
+    double p90 = 0; /** 90. percentyl probek */
+    double p99 = 0; /** 99. percentyl probek */
+    double max = 0; /** Najdluzsza probka */
+
+    /**
+     * Wylicza statystyki z probek
+     * @param samples
+     * @return statystyki
+     */
+    static BenchmarkStatistics of(std::vector<double> samples);
+};
+
+/**
+ * Wynik jednego pomiaru
+ */
+struct BenchmarkResult {
+    std::string group; /** Mierzona operacja */
+    std::string scalar; /** Typ skalara */
+    size_t size = 0; /** Rozmiar danych */
+    size_t iterations = 0; /** Liczba wywolan w jednej probce */
+    size_t samples = 0; /** Liczba probek */
+    BenchmarkStatistics nanoseconds; /** Czas jednego wywolania */
+    double allocations = 0; /** Srednia liczba alokacji pamieci (operator new) w jednym wywolaniu */
+
+    /**
+     * Zwraca nazwe pomiaru grupa/skalar/rozmiar
+     * @return nazwa
+     */
+    std::string name() const;
+};
+
+/**
+ * Zestaw pomiarow: kazda funkcja wywolywana jest najpierw na rozgrzewke, a potem w probkach, z ktorych
+ * kazda powtarza wywolanie tyle razy, by trwala co najmniej sample_time (krotkie operacje nie gina
+ * w rozdzielczosci zegara); wyniki to statystyki czasu jednego wywolania
+ */
+class Benchmark {
+public:
+    size_t warmup = 3; /** Liczba probek rozgrzewkowych */
+    size_t samples = 21; /** Liczba mierzonych probek */
+    std::chrono::nanoseconds sample_time = std::chrono::milliseconds(2); /** Najkrotszy czas probki */
+    std::string filter; /** Mierzone sa tylko pomiary, ktorych nazwa zawiera ten napis */
+
+    /**
+     * Mierzy funkcje, jesli nazwa pomiaru pasuje do filtra
+     * @tparam F
+     * @param group
+     * @param scalar
+     * @param size
+     * @param function
+     */
+    template <class F>
+    void run(const std::string& group, const std::string& scalar, size_t size, F function);
+
+    /**
+     * Zwraca liczbe wywolan operatora new od startu programu (zad3_bench zastepuje globalny operator new
+     * wersja liczaca alokacje)
+     * @return liczba alokacji
+     */
+    static uint64_t allocations();
+
+    /**
+     * Zwraca wyniki wykonanych pomiarow
+     * @return wyniki
+     */
+    const std::vector<BenchmarkResult>& results() const;
+
+    /**
+     * Wypisuje wyniki jako tabele
+     * @param out
+     */
+    void write_table(std::ostream& out) const;
+
+    /**
+     * Wypisuje wyniki w formacie JSON
+     * @param out
+     */
+    void write_json(std::ostream& out) const;
+
+private:
+    std::vector<BenchmarkResult> measured; /** Wyniki */
+
+    /**
+     * Czy pomiar o podanej nazwie ma byc wykonany
+     * @param name
+     * @return true jesli nazwa pasuje do filtra
+     */
+    bool selected(const std::string& name) const;
+
+    /**
+     * Wypisuje biezacy wynik na standardowe wyjscie bledow, zeby bylo widac postep
+     * @param result
+     */
+    static void report(const BenchmarkResult& result);
+};
+
+template <class F>
+void Benchmark::run(const std::string& group, const std::string& scalar, const size_t size, F function) {
+    using clock = std::chrono::steady_clock;
+
+    BenchmarkResult result;
+    result.group = group;
+    result.scalar = scalar;
+    result.size = size;
+    if (!selected(result.name()))
+        return;
+
+    const auto batch = [&function](const size_t iterations) {
+        const auto start = clock::now();
+        for (size_t i = 0; i < iterations; i++)
+            function();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+    };
+
+    /* liczba wywolan w probce podwajana, az probka bedzie dosc dluga; to zarazem pierwsza rozgrzewka */
+    size_t iterations = 1;
+    while (batch(iterations) < sample_time)
+        iterations *= 2;
+
+    for (size_t i = 0; i < warmup; i++)
+        batch(iterations);
+
+    std::vector<double> times(samples);
+    const uint64_t allocated = allocations();
+    for (double& time : times)
+        time = static_cast<double>(batch(iterations).count()) / static_cast<double>(iterations);
+
+    result.iterations = iterations;
+    result.samples = samples;
+    result.nanoseconds = BenchmarkStatistics::of(std::move(times));
+    result.allocations = static_cast<double>(allocations() - allocated) / static_cast<double>(iterations * samples);
+    report(result);
+    measured.push_back(std::move(result));
+}
+
+#endif //ZAD3_BENCHMARK_HH
@@ -0,0 +1,396 @@
+#ifndef ZAD3_BINARYFORMAT_HH
+#define ZAD3_BINARYFORMAT_HH
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "../inc/Complex.hh"
+#include "../inc/LinearEquation.hh"
+#include "../inc/MappedFile.hh"
+#include "../inc/Instrumentation.hh"
+
+/* plik binarny: 64-bajtowy naglowek i count rekordow o stalej dlugosci; rekord ukladu to macierz A
+ * zapisana wierszami i wektor b, rekord rozwiazania to wektory x i Ax-b; kazda czesc rekordu zaczyna sie
+ * na granicy 64 bajtow, a liczby zespolone zapisane sa jak w pamieci Complex<T> (re, im), wiec dane
+ * kopiowane sa do macierzy i wektorow jednym memcpy, bez parsowania */
+
+/**
+ * Zawartosc pliku binarnego
+ */
+enum class BinaryContent : uint8_t {
+    systems = 0, /** Uklady rownan (A, b) */
+    solutions = 1 /** Rozwiazania (x, Ax-b) */
+};
+
+/**
+ * Naglowek pliku binarnego, zapisywany w porzadku bajtow maszyny piszacej
+ */
+struct BinaryHeader {
+    char magic[4]; /** Sygnatura ZAD3 */
+    uint16_t version; /** Wersja formatu */
+    uint8_t complex; /** 1 dla liczb zespolonych */
+    uint8_t width; /** Liczba bajtow czesci rzeczywistej skalara (4 lub 8) */
+    uint32_t byte_order; /** binary_byte_order zapisane przez maszyne piszaca */
+    uint8_t content; /** BinaryContent */
+    uint8_t reserved[3]; /** Zarezerwowane, zera */
+    uint64_t size; /** Liczba niewiadomych kazdego ukladu */
+    uint64_t count; /** Liczba rekordow */
+    uint8_t padding[32]; /** Dopelnienie do 64 bajtow */
+};
+
+static_assert(sizeof(BinaryHeader) == 64, "Binary header must be 64 bytes");
+
+constexpr char binary_magic[4] = {'Z', 'A', 'D', '3'}; /** Sygnatura pliku */
+constexpr uint16_t binary_version = 1; /** Biezaca wersja formatu */
+constexpr uint32_t binary_byte_order = 0x01020304; /** Znacznik porzadku bajtow */
+constexpr size_t binary_alignment = 64; /** Wyrownanie czesci rekordu */
+
+/**
+ * Opis skalara T w naglowku
+ * @tparam T
+ */
+template <class T>
+struct BinaryScalar {
+    static_assert(std::is_floating_point<T>::value, "Binary format stores floating point scalars only");
+
+    static constexpr bool complex = false; /** Czy skalar jest liczba zespolona */
+    static constexpr uint8_t width = sizeof(T); /** Liczba bajtow czesci rzeczywistej */
+};
+
+/**
+ * Czesciowa specjalizacja dla liczb zespolonych
+ * @tparam T
+ */
+template <class T>
+struct BinaryScalar<Complex<T>> {
+    static_assert(sizeof(Complex<T>) == 2 * sizeof(T), "Complex must be stored as (re, im)");
+
+    static constexpr bool complex = true;
+    static constexpr uint8_t width = BinaryScalar<T>::width;
+};
+
+/**
+ * Zaokragla liczbe bajtow w gore do wielokrotnosci binary_alignment
+ * @param bytes
+ * @return liczba bajtow
+ */
+constexpr size_t binary_align(const size_t bytes) {
+    return (bytes + binary_alignment - 1) / binary_alignment * binary_alignment;
+}
+
+/**
+ * Plik binarny zmapowany w pamieci; rekordy dostepne bez kopiowania jako wskazniki na skalary
+ * lub kopiowane do rownan
+ */
+class BinaryFile {
+public:
+    /**
+     * Mapuje i sprawdza plik
+     * @param path
+     */
+    explicit BinaryFile(const std::string& path);
+
+    /**
+     * Sprawdza naglowek juz zmapowanego pliku
+     * @param file
+     */
+    explicit BinaryFile(MappedFile&& file);
+
+    /**
+     * Sprawdza, czy bufor zaczyna sie sygnatura pliku binarnego
+     * @param data
+     * @param size
+     * @return true dla pliku binarnego
+     */
+    static bool detect(const char* data, size_t size);
+
+    /**
+     * Zwraca naglowek
+     * @return naglowek
+     */
+    const BinaryHeader& header() const;
+
+    /**
+     * Zwraca liczbe niewiadomych ukladow
+     * @return rozmiar
+     */
+    size_t size() const;
+
+    /**
+     * Zwraca liczbe rekordow
+     * @return liczba rekordow
+     */
+    size_t count() const;
+
+    /**
+     * Zwraca zawartosc pliku
+     * @return zawartosc
+     */
+    BinaryContent content() const;
+
+    /**
+     * Sprawdza, czy skalary pliku sa typu T
+     * @return true jesli typ sie zgadza
+     */
+    template <class T>
+    bool holds() const;
+
+    /**
+     * Zwraca pierwsza czesc i-tego rekordu (macierz A lub wektor x)
+     * @param i
+     * @return wskaznik na skalary
+     */
+    template <class T>
+    const T* first(size_t i) const;
+
+    /**
+     * Zwraca druga czesc i-tego rekordu (wektor b lub Ax-b)
+     * @param i
+     * @return wskaznik na skalary
+     */
+    template <class T>
+    const T* second(size_t i) const;
+
+    /**
+     * Kopiuje i-ty uklad do rownania
+     * @param i
+     * @param equation
+     */
+    template <class T>
+    void load(size_t i, DynamicLinearEquation<T>& equation) const;
+
+    /**
+     * Kopiuje i-ty uklad do rownania o stalym rozmiarze
+     * @param i
+     * @param equation
+     */
+    template <class T, size_t n>
+    void load(size_t i, LinearEquation<T, n>& equation) const;
+
+    /**
+     * Zwalnia strony rekordow przed i-tym (czytanie po kolei)
+     * @param i
+     */
+    void release(size_t i);
+
+private:
+    MappedFile file; /** Zmapowany plik */
+
+    /**
+     * Zwraca poczatek i-tego rekordu sprawdzajac typ skalara i zakres
+     * @param i
+     * @return wskaznik na rekord
+     */
+    template <class T>
+    const char* record(size_t i) const;
+
+    /**
+     * Zwraca przesuniecie drugiej czesci rekordu
+     * @return liczba bajtow
+     */
+    size_t second_offset() const;
+
+    /**
+     * Zwraca dlugosc rekordu
+     * @return liczba bajtow
+     */
+    size_t stride() const;
+};
+
+template <class T>
+bool BinaryFile::holds() const {
+    return header().complex == BinaryScalar<T>::complex && header().width == BinaryScalar<T>::width;
+}
+
+template <class T>
+const char* BinaryFile::record(const size_t i) const {
+    if (!holds<T>())
+        throw std::runtime_error("Scalar type mismatch");
+    if (i >= count())
+        throw std::runtime_error("Index out of range");
+    return file.data() + sizeof(BinaryHeader) + i * stride();
+}
+
+template <class T>
+const T* BinaryFile::first(const size_t i) const {
+    return reinterpret_cast<const T*>(record<T>(i));
+}
+
+template <class T>
+const T* BinaryFile::second(const size_t i) const {
+    return reinterpret_cast<const T*>(record<T>(i) + second_offset());
+}
+
+template <class T>
+void BinaryFile::load(const size_t i, DynamicLinearEquation<T>& equation) const {
+    if (content() != BinaryContent::systems)
+        throw std::runtime_error("File does not contain systems");
+
+    const size_t n = size();
+    ZAD3_PHASE(Phase::load, 0, (n * n + n) * sizeof(T));
+    equation.factor_matrix = DynamicMatrix<T>(n, n);
+    equation.result_vector = DynamicVector<T>(n);
+    std::memcpy(equation.factor_matrix.data(), first<T>(i), n * n * sizeof(T));
+    std::memcpy(equation.result_vector.data(), second<T>(i), n * sizeof(T));
+}
+
+template <class T, size_t n>
+void BinaryFile::load(const size_t i, LinearEquation<T, n>& equation) const {
+    if (content() != BinaryContent::systems)
+        throw std::runtime_error("File does not contain systems");
+    if (size() != n)
+        throw std::runtime_error("Size mismatch");
+
+    ZAD3_PHASE(Phase::load, 0, (n * n + n) * sizeof(T));
+    const T* matrix = first<T>(i);
+    for (size_t x = 0; x < n; x++)
+        std::memcpy(equation.factor_matrix[x].data(), matrix + x * n, n * sizeof(T));
+    std::memcpy(equation.result_vector.data(), second<T>(i), n * sizeof(T));
+}
+
+/**
+ * Zapis pliku binarnego o skalarach T; liczba rekordow uzupelniana w naglowku przy zamknieciu
+ * @tparam T
+ */
+template <class T>
+class BinaryWriter {
+public:
+    /**
+     * Tworzy plik i zapisuje naglowek
+     * @param path
+     * @param content
+     * @param size liczba niewiadomych kazdego ukladu
+     */
+    BinaryWriter(const std::string& path, BinaryContent content, size_t size);
+
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+    /**
+     * Uzupelnia naglowek i zamyka plik, jesli nie zrobiono tego przez close(); blad zapisu jest pomijany,
+     * bo wyjatek z destruktora (np. w trakcie zwijania stosu) konczylby program
+     */
+    ~BinaryWriter();
+
+    /**
+     * Dopisuje uklad (A, b) albo rozwiazanie (x, Ax-b), zaleznie od zawartosci pliku
+     * @param equation
+     */
+    void write(const DynamicLinearEquation<T>& equation);
+
+    /**
+     * @see write
+     */
+    template <size_t size>
+    void write(const LinearEquation<T, size>& equation);
+
+    /**
+     * Uzupelnia naglowek i zamyka plik
+     */
+    void close();
+
+private:
+    std::ofstream out; /** Plik */
+    BinaryHeader header{}; /** Naglowek */
+
+    /**
+     * Uzupelnia naglowek i zamyka plik bez zglaszania bledu
+     * @return false jesli zapis sie nie powiodl
+     */
+    bool finish() noexcept;
+
+    /**
+     * Dopisuje skalary i dopelnia do granicy wyrownania
+     * @param scalars
+     * @param count
+     */
+    void write_part(const T* scalars, size_t count);
+};
+
+template <class T>
+BinaryWriter<T>::BinaryWriter(const std::string& path, const BinaryContent content, const size_t size)
+        : out(path, std::ios::binary | std::ios::trunc) {
+    if (!out)
+        throw std::runtime_error("Cannot open file " + path);
+
+    std::memcpy(header.magic, binary_magic, sizeof(header.magic));
+    header.version = binary_version;
+    header.complex = BinaryScalar<T>::complex;
+    header.width = BinaryScalar<T>::width;
+    header.byte_order = binary_byte_order;
+    header.content = static_cast<uint8_t>(content);
+    header.size = size;
+    header.count = 0;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+template <class T>
+BinaryWriter<T>::~BinaryWriter() {
+    if (out.is_open())
+        finish();
+}
+
+template <class T>
+void BinaryWriter<T>::write_part(const T* scalars, const size_t count) {
+    static const char zeros[binary_alignment] = {};
+
+    const size_t bytes = count * sizeof(T);
+    out.write(reinterpret_cast<const char*>(scalars), bytes);
+    out.write(zeros, binary_align(bytes) - bytes);
+}
+
+template <class T>
+void BinaryWriter<T>::write(const DynamicLinearEquation<T>& equation) {
+    if (equation.size() != header.size)
+        throw std::runtime_error("Size mismatch");
+
+    if (header.content == static_cast<uint8_t>(BinaryContent::systems)) {
+        write_part(equation.factor_matrix.data(), header.size * header.size);
+        write_part(equation.result_vector.data(), header.size);
+    } else {
+        write_part(equation.unknown_vector.data(), header.size);
+        write_part(equation.error_vector.data(), header.size);
+    }
+    header.count++;
+}
+
+template <class T>
+template <size_t size>
+void BinaryWriter<T>::write(const LinearEquation<T, size>& equation) {
+    static const char zeros[binary_alignment] = {};
+
+    if (size != header.size)
+        throw std::runtime_error("Size mismatch");
+
+    if (header.content == static_cast<uint8_t>(BinaryContent::systems)) {
+        for (size_t x = 0; x < size; x++)
+            out.write(reinterpret_cast<const char*>(equation.factor_matrix[x].data()), size * sizeof(T));
+        out.write(zeros, binary_align(size * size * sizeof(T)) - size * size * sizeof(T));
+        write_part(equation.result_vector.data(), size);
+    } else {
+        write_part(equation.unknown_vector.data(), size);
+        write_part(equation.error_vector.data(), size);
+    }
+    header.count++;
+}
+
+template <class T>
+void BinaryWriter<T>::close() {
+    if (!finish())
+        throw std::runtime_error("Cannot write file");
+}
+
+template <class T>
+bool BinaryWriter<T>::finish() noexcept {
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    return !out.fail();
+}
+
+#endif //ZAD3_BINARYFORMAT_HH
@@ -0,0 +1,289 @@
+#ifndef ZAD3_BLOCKEDFACTORIZATION_HH
+#define ZAD3_BLOCKEDFACTORIZATION_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Scalar.hh"
+#include "../inc/Kernels.hh"
+#include "../inc/Factorization.hh"
+#include "../inc/AlignedAllocator.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/ThreadPool.hh"
+
+/**
+ * Blokowy rozklad LU (right-looking): kolumny rozkladane sa pasami szerokosci panel_width, a reszta
+ * macierzy aktualizowana raz na pas mnozeniem kafelkow zamiast raz na kolumne; przy duzych macierzach
+ * reszta macierzy przechodzi przez cache panel_width razy rzadziej
+ * @tparam T
+ */
+template <class T>
+struct BlockedFactorization {
+    /* rozmiary w bajtach: kafelek U12 (panel_width x column_tile) to 128 KiB i miesci sie w L2,
+     * fragment wiersza C (column_tile skalarow) to 2 KiB i pozostaje w L1 */
+
+    static constexpr size_t panel_width = 64; /** Szerokosc pasa kolumn */
+    static constexpr size_t column_tile = 2048 / sizeof(T); /** Szerokosc kafelka aktualizacji */
+    static constexpr size_t row_tile = 128; /** Wysokosc kafelka aktualizacji */
+    static constexpr size_t panel_leaf = 16; /** Szerokosc czesci pasa rozkladanej kolumna po kolumnie */
+    static constexpr size_t task_rows = 256; /** Liczba wierszy aktualizowanych przez jedno zadanie puli */
+    static constexpr size_t threshold = 1024 / sizeof(T); /** Rozmiar, od ktorego oplaca sie rozklad blokowy (i pula watkow w main.cc) */
+
+    /**
+     * Rozklada macierz kwadratowa w miejscu na L i U jak Factorization::decompose
+     * @param matrix
+     * @param permutation permutation[i] - indeks wiersza wejsciowego na i-tej pozycji
+     * @return true jesli permutacja jest nieparzysta
+     */
+    static bool decompose(DynamicMatrix<T>& matrix, size_t* permutation);
+
+    /**
+     * Rozklada macierz jak decompose(matrix, permutation) na watkach puli: rozklad pasa, rozwiazanie
+     * trojkatne i aktualizacja kafelkow sa zadaniami zlecanymi, gdy tylko ich dane sa gotowe, wiec
+     * rozklad kolejnego pasa zaczyna sie przed koncem aktualizacji reszty macierzy poprzednim pasem
+     * @param matrix
+     * @param permutation
+     * @param pool
+     * @return true jesli permutacja jest nieparzysta
+     */
+    static bool decompose(DynamicMatrix<T>& matrix, size_t* permutation, ThreadPool& pool);
+
+private:
+    /**
+     * Rozklada kolumny [k0, k1) ponizej wiersza k0, zamieniajac wiersze tylko w obrebie pasa
+     * @param matrix
+     * @param pivots pivots[k] - wiersz zamieniony z k-tym
+     * @param k0
+     * @param k1
+     */
+    static void factor_panel(DynamicMatrix<T>& matrix, size_t* pivots, size_t k0, size_t k1);
+
+    /**
+     * Zamienia wiersze pasa [k0, k1) w kolumnach [j0, j1) i wylicza tam U12 = L11^-1 A12
+     * @param matrix
+     * @param pivots
+     * @param k0
+     * @param k1
+     * @param j0
+     * @param j1
+     */
+    static void solve_panel_rows(DynamicMatrix<T>& matrix, const size_t* pivots, size_t k0, size_t k1, size_t j0, size_t j1);
+
+    /**
+     * Wylicza A22 -= L21 U12 dla wierszy [i0, i1) i kolumn [j0, j1) kafelkami
+     * @param matrix
+     * @param k0
+     * @param k1
+     * @param i0
+     * @param i1
+     * @param j0
+     * @param j1
+     */
+    static void subtract(DynamicMatrix<T>& matrix, size_t k0, size_t k1, size_t i0, size_t i1, size_t j0, size_t j1);
+
+    /**
+     * Zamienia wiersze w kolumnach na lewo od kazdego pasa i sklada zamiany w permutacje
+     * @param matrix
+     * @param pivots
+     * @param permutation
+     * @return true jesli permutacja jest nieparzysta
+     */
+    static bool permute(DynamicMatrix<T>& matrix, const size_t* pivots, size_t* permutation);
+};
+
+template <class T>
+void BlockedFactorization<T>::factor_panel(DynamicMatrix<T>& matrix, size_t* pivots, const size_t k0, const size_t k1) {
+    const size_t n = matrix.rows();
+
+    /* pas dzielony rekurencyjnie na polowy, zeby i w nim wiekszosc pracy wykonalo gemm_subtract */
+    if (k1 - k0 > panel_leaf) {
+        const size_t middle = k0 + (k1 - k0) / 2;
+
+        factor_panel(matrix, pivots, k0, middle);
+        solve_panel_rows(matrix, pivots, k0, middle, middle, k1);
+        subtract(matrix, k0, middle, middle, n, middle, k1);
+        factor_panel(matrix, pivots, middle, k1);
+
+        for (size_t k = middle; k < k1; k++)
+            if (pivots[k] != k)
+                std::swap_ranges(matrix[k] + k0, matrix[k] + middle, matrix[pivots[k]] + k0);
+        return;
+    }
+
+    /* waski pas przepisywany do ciaglego bufora, w ktorym wiersze pasa leza obok siebie */
+    const size_t width = k1 - k0;
+    std::vector<T, AlignedAllocator<T>> panel((n - k0) * width);
+
+    for (size_t x = k0; x < n; x++)
+        std::copy(matrix[x] + k0, matrix[x] + k1, panel.data() + (x - k0) * width);
+
+    for (size_t k = 0; k < width; k++) {
+        T* row = panel.data() + k * width;
+
+        size_t x_pivot = k;
+        auto pivot_magnitude = Scalar<T>::magnitude(row[k]);
+        for (size_t x = k + 1; x < n - k0; x++) {
+            const auto magnitude = Scalar<T>::magnitude(panel[x * width + k]);
+            if (magnitude > pivot_magnitude) {
+                x_pivot = x;
+                pivot_magnitude = magnitude;
+            }
+        }
+
+        if (pivot_magnitude == 0)
+            throw std::runtime_error("Singular matrix");
+
+        pivots[k0 + k] = k0 + x_pivot;
+        if (x_pivot != k)
+            std::swap_ranges(row, row + width, panel.data() + x_pivot * width);
+
+        const T diagonal = row[k];
+        for (size_t x = k + 1; x < n - k0; x++) {
+            T* other = panel.data() + x * width;
+            const T factor = other[k] / diagonal;
+            other[k] = factor;
+            for (size_t y = k + 1; y < width; y++)
+                other[y] -= factor * row[y];
+        }
+    }
+
+    for (size_t x = k0; x < n; x++)
+        std::copy(panel.data() + (x - k0) * width, panel.data() + (x - k0 + 1) * width, matrix[x] + k0);
+}
+
+template <class T>
+void BlockedFactorization<T>::solve_panel_rows(DynamicMatrix<T>& matrix, const size_t* pivots, const size_t k0,
+                                               const size_t k1, const size_t j0, const size_t j1) {
+    for (size_t k = k0; k < k1; k++)
+        if (pivots[k] != k)
+            std::swap_ranges(matrix[k] + j0, matrix[k] + j1, matrix[pivots[k]] + j0);
+
+    for (size_t x = k0 + 1; x < k1; x++)
+        for (size_t y = k0; y < x; y++)
+            Kernels<T>::axpy(T(0) - matrix[x][y], matrix[y] + j0, matrix[x] + j0, j1 - j0);
+}
+
+template <class T>
+void BlockedFactorization<T>::subtract(DynamicMatrix<T>& matrix, const size_t k0, const size_t k1, const size_t i0,
+                                       const size_t i1, const size_t j0, const size_t j1) {
+    const size_t stride = matrix.columns();
+
+    for (size_t j = j0; j < j1; j += column_tile)
+        for (size_t i = i0; i < i1; i += row_tile)
+            Kernels<T>::gemm_subtract(matrix[i] + k0, stride, matrix[k0] + j, stride, matrix[i] + j, stride,
+                                      std::min(row_tile, i1 - i), std::min(column_tile, j1 - j), k1 - k0);
+}
+
+template <class T>
+bool BlockedFactorization<T>::permute(DynamicMatrix<T>& matrix, const size_t* pivots, size_t* permutation) {
+    const size_t n = matrix.rows();
+    bool odd = false;
+
+    for (size_t i = 0; i < n; i++)
+        permutation[i] = i;
+
+    for (size_t k = 0; k < n; k++) {
+        if (pivots[k] == k)
+            continue;
+
+        const size_t k0 = k / panel_width * panel_width;
+        std::swap_ranges(matrix[k], matrix[k] + k0, matrix[pivots[k]]);
+        std::swap(permutation[k], permutation[pivots[k]]);
+        odd = !odd;
+    }
+
+    return odd;
+}
+
+template <class T>
+bool BlockedFactorization<T>::decompose(DynamicMatrix<T>& matrix, size_t* permutation) {
+    const size_t n = matrix.rows();
+    std::vector<size_t, AlignedAllocator<size_t>> pivots(n);
+
+    for (size_t k0 = 0; k0 < n; k0 += panel_width) {
+        const size_t k1 = std::min(k0 + panel_width, n);
+
+        factor_panel(matrix, pivots.data(), k0, k1);
+        for (size_t j = k1; j < n; j += column_tile) {
+            const size_t j1 = std::min(j + column_tile, n);
+            solve_panel_rows(matrix, pivots.data(), k0, k1, j, j1);
+            subtract(matrix, k0, k1, k1, n, j, j1);
+        }
+    }
+
+    return permute(matrix, pivots.data(), permutation);
+}
+
+template <class T>
+bool BlockedFactorization<T>::decompose(DynamicMatrix<T>& matrix, size_t* permutation, ThreadPool& pool) {
+    /* graf zadan na blokach kolumn szerokosci panel_width: aktualizacja bloku j pasem k (rozwiazanie
+     * trojkatne, a po nim kafelki po task_rows wierszy) czeka na rozklad pasa k i na aktualizacje bloku j
+     * pasem k - 1; rozklad pasa k + 1 czeka tylko na aktualizacje jego bloku pasem k, ktora zlecana jest
+     * jako ostatnia, wiec watek zlecajacy wykonuje ja pierwsza */
+
+    const size_t n = matrix.rows();
+    const size_t blocks = (n + panel_width - 1) / panel_width;
+    std::vector<size_t, AlignedAllocator<size_t>> pivots(n);
+
+    /* dla pary (k, j): liczba niespelnionych zaleznosci aktualizacji i liczba niezakonczonych kafelkow */
+    std::unique_ptr<std::atomic<size_t>[]> dependencies(new std::atomic<size_t>[blocks * blocks]);
+    std::unique_ptr<std::atomic<size_t>[]> tiles(new std::atomic<size_t>[blocks * blocks]);
+    for (size_t k = 0; k < blocks; k++)
+        for (size_t j = k + 1; j < blocks; j++)
+            dependencies[k * blocks + j] = k == 0 ? 1 : 2;
+
+    const auto begin = [](const size_t block) { return block * panel_width; };
+    const auto end = [n](const size_t block) { return std::min((block + 1) * panel_width, n); };
+
+    TaskGroup group;
+    std::function<void(size_t)> panel;
+    std::function<void(size_t, size_t)> release;
+
+    /* zakonczenie aktualizacji bloku j pasem k */
+    const auto updated = [&](const size_t k, const size_t j) {
+        if (j == k + 1)
+            panel(j);
+        else
+            release(k + 1, j);
+    };
+
+    panel = [&](const size_t k) {
+        factor_panel(matrix, pivots.data(), begin(k), end(k));
+        for (size_t j = blocks; j-- > k + 1;)
+            release(k, j);
+    };
+
+    release = [&](const size_t k, const size_t j) {
+        if (--dependencies[k * blocks + j] > 0)
+            return;
+
+        pool.run(group, [&, k, j] {
+            solve_panel_rows(matrix, pivots.data(), begin(k), end(k), begin(j), end(j));
+
+            const size_t first = end(k);
+            const size_t count = (n - first + task_rows - 1) / task_rows;
+            tiles[k * blocks + j] = count;
+
+            for (size_t t = count; t-- > 0;) {
+                pool.run(group, [&, k, j, first, t] {
+                    const size_t i0 = first + t * task_rows;
+                    subtract(matrix, begin(k), end(k), i0, std::min(i0 + task_rows, n), begin(j), end(j));
+                    if (--tiles[k * blocks + j] == 0)
+                        updated(k, j);
+                });
+            }
+        });
+    };
+
+    pool.run(group, [&] { panel(0); });
+    pool.wait(group);
+
+    return permute(matrix, pivots.data(), permutation);
+}
+
+#endif //ZAD3_BLOCKEDFACTORIZATION_HH
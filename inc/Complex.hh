@@ -14,20 +14,27 @@
 template <class T>
 class Complex {
 public:
-    T real;
-    T imaginary;
+    T real{};
+    T imaginary{};
 
     /**
      * Tworzy liczbe z podanych wartosci
      * @param real
      * @param imaginary
      */
-    Complex(T real, T imaginary = 0);
+    constexpr Complex(T real, T imaginary = 0);
 
     /**
      * Tworzy liczbe (0, 0)
      */
-    Complex() = default;
+    constexpr Complex() = default;
+
+    /**
+     * Tworzy liczbe z liczby o skalarach innego typu (zmiana precyzji)
+     * @param complex
+     */
+    template <class U>
+    explicit constexpr Complex(const Complex<U>& complex);
 
     /**
      * Wylicza wartosc bezwzgledna
@@ -39,56 +46,63 @@ public:
      * Sprzezenie liczby
      * @return sprzezona liczbe
      */
-    Complex<T> conjugate() const;
+    constexpr Complex<T> conjugate() const;
 
     /**
      * Operator dodawania liczb
      * @param complex
      * @return liczba
      */
-    Complex<T> operator+(const Complex<T>& complex) const;
+    constexpr Complex<T> operator+(const Complex<T>& complex) const;
 
     /**
      * Operator odejmowania liczb
      * @param complex
      * @return liczba
      */
-    Complex<T> operator-(const Complex<T>& complex) const;
+    constexpr Complex<T> operator-(const Complex<T>& complex) const;
 
     /**
      * Operator mnozenia liczb
      * @param complex
      * @return liczba
      */
-    Complex<T> operator*(const Complex<T>& complex) const;
+    constexpr Complex<T> operator*(const Complex<T>& complex) const;
 
     /**
      * Operator dzielenia liczb
      * @param complex
      * @return liczba
      */
-    Complex<T> operator/(const Complex<T>& complex) const;
+    constexpr Complex<T> operator/(const Complex<T>& complex) const;
 
     /**
      * Operator dodawania z przypisaniem liczb
      * @param complex
      * @return referencje na liczbe
      */
-    Complex<T>& operator+=(const Complex<T>& complex);
+    constexpr Complex<T>& operator+=(const Complex<T>& complex);
+
+    /**
+     * Operator odejmowania z przypisaniem liczb
+     * @param complex
+     * @return referencje na liczbe
+     */
+    constexpr Complex<T>& operator-=(const Complex<T>& complex);
 
     /**
      * Operator mnozenia liczby przez skalar
      * @param complex
      * @return liczba
      */
-    Complex<T> operator*(T value) const;
+    constexpr Complex<T> operator*(T value) const;
 
     /**
      * Operator dzielenia liczby przez skalar
      * @param complex
      * @return liczba
      */
-    Complex<T> operator/(T value) const;
+    constexpr Complex<T> operator/(T value) const;
 
     /* niezalezna templatka, zeby uniknac problemow kompilacji */
 
@@ -108,6 +122,17 @@ public:
     template <class _T>
     friend std::ostream& operator<<(std::ostream& out, const Complex<_T>& complex);
 
+    /**
+     * Parser bufora (Parser.hh) uzywa tych samych znakow formatu
+     */
+    template <class _T>
+    friend struct ScalarParser;
+
+    /**
+     * Bufor wyjscia (Writer.hh) rowniez
+     */
+    friend class Writer;
+
 private:
     static const char opening_parenthesis = '('; /** Znak nawiasu otwierajacego */
     static const char closing_parenthesis = ')'; /** Znak nawiasu zamykajacego */
@@ -115,30 +140,35 @@ private:
 };
 
 template <class T>
-Complex<T>::Complex(T real, T imaginary) : real(real), imaginary(imaginary) {}
+constexpr Complex<T>::Complex(T real, T imaginary) : real(real), imaginary(imaginary) {}
+
+template <class T>
+template <class U>
+constexpr Complex<T>::Complex(const Complex<U>& complex)
+        : real(static_cast<T>(complex.real)), imaginary(static_cast<T>(complex.imaginary)) {}
 
 template <class T>
 double Complex<T>::abs() const {
-    return std::sqrt(std::pow(real, 2) + std::pow(imaginary, 2));
+    return std::sqrt(real * real + imaginary * imaginary);
 }
 
 template <class T>
-Complex<T> Complex<T>::conjugate() const {
+constexpr Complex<T> Complex<T>::conjugate() const {
     return Complex<T>(real, imaginary * (-1));
 }
 
 template <class T>
-Complex<T> Complex<T>::operator+(const Complex<T> &complex) const {
+constexpr Complex<T> Complex<T>::operator+(const Complex<T> &complex) const {
     return Complex<T>(real + complex.real, imaginary + complex.imaginary);
 }
 
 template <class T>
-Complex<T> Complex<T>::operator-(const Complex<T> &complex) const {
+constexpr Complex<T> Complex<T>::operator-(const Complex<T> &complex) const {
     return Complex<T>(real - complex.real, imaginary - complex.imaginary);
 }
 
 template <class T>
-Complex<T> Complex<T>::operator*(const Complex<T> &complex) const {
+constexpr Complex<T> Complex<T>::operator*(const Complex<T> &complex) const {
     return Complex<T>(
             real * complex.real - imaginary * complex.imaginary,
             real * complex.imaginary + imaginary * complex.real
@@ -146,26 +176,34 @@ Complex<T> Complex<T>::operator*(const Complex<T> &complex) const {
 }
 
 template <class T>
-Complex<T> Complex<T>::operator/(const Complex<T> &complex) const {
-    return ((*this) * complex.conjugate()) / std::pow(complex.abs(), 2);
+constexpr Complex<T> Complex<T>::operator/(const Complex<T> &complex) const {
+    /* kwadrat modulu liczony wprost, bez pierwiastka i potegowania */
+    return ((*this) * complex.conjugate()) / (complex.real * complex.real + complex.imaginary * complex.imaginary);
 }
 
 template <class T>
-Complex<T>& Complex<T>::operator+=(const Complex<T> &complex) {
+constexpr Complex<T>& Complex<T>::operator+=(const Complex<T> &complex) {
     real += complex.real;
     imaginary += complex.imaginary;
     return *this;
 }
 
 template <class T>
-Complex<T> Complex<T>::operator*(const T value) const {
+constexpr Complex<T>& Complex<T>::operator-=(const Complex<T> &complex) {
+    real -= complex.real;
+    imaginary -= complex.imaginary;
+    return *this;
+}
+
+template <class T>
+constexpr Complex<T> Complex<T>::operator*(const T value) const {
     return Complex<T>(
             real * value, imaginary * value
     );
 }
 
 template <class T>
-Complex<T> Complex<T>::operator/(const T value) const {
+constexpr Complex<T> Complex<T>::operator/(const T value) const {
     return Complex<T>(
             real / value, imaginary / value
     );
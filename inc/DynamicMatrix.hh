@@ -0,0 +1,370 @@
+#ifndef ZAD3_DYNAMICMATRIX_HH
+#define ZAD3_DYNAMICMATRIX_HH
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Complex.hh"
+#include "../inc/AlignedAllocator.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/Factorization.hh"
+#include "../inc/MatrixView.hh"
+
+/**
+ * Klasa reprezentujaca macierz o skalarach T i wymiarach ustalanych w czasie wykonania,
+ * przechowywana wierszami w ciaglej, wyrownanej pamieci na stercie
+ * @tparam T
+ */
+template <class T>
+class DynamicMatrix {
+
+public:
+    using scalar_type = T; /** Typ skalara */
+    using vector_type = DynamicVector<T>; /** Typ wektora o dlugosci rownej liczbie wierszy */
+
+    /**
+     * Tworzy macierz o podanych wymiarach i wszystkich skalarach rownych podanemu
+     * @param rows
+     * @param columns
+     * @param scalar
+     */
+    DynamicMatrix(size_t rows, size_t columns, T scalar = T());
+
+    /**
+     * Tworzy macierz pusta
+     */
+    DynamicMatrix() = default;
+
+    /**
+     * Tworzy macierz przepisujac skalary z widoku
+     * @param view
+     */
+    template <class D>
+    DynamicMatrix(const MatrixView<D>& view);
+
+    /**
+     * Zwraca liczbe wierszy
+     * @return liczba wierszy
+     */
+    size_t rows() const;
+
+    /**
+     * Zwraca liczbe kolumn
+     * @return liczba kolumn
+     */
+    size_t columns() const;
+
+    /**
+     * Zwraca wskaznik na poczatek danych
+     * @return wskaznik
+     */
+    const T* data() const;
+
+    /**
+     * Zwraca wskaznik na poczatek danych
+     * @return wskaznik
+     */
+    T* data();
+
+    /**
+     * Wylicza wyznacznik eliminacja Gaussa
+     * @return wartosc
+     */
+    T det() const;
+
+    /**
+     * Transpozycjonuje macierz
+     * @return macierz transponowana
+     */
+    DynamicMatrix<T> transpose() const;
+
+    /**
+     * Tworzy widok na transpozycje macierzy bez przepisywania skalarow
+     * @return widok
+     */
+    TransposedView<const DynamicMatrix<T>> transposed() const;
+
+    /**
+     * Tworzy widok na macierz z j-ta kolumna podmieniona na wektor
+     * @param vector
+     * @param j
+     * @return widok
+     */
+    ReplacedColumnView<DynamicMatrix<T>, DynamicVector<T>> replace_column(const DynamicVector<T>& vector, size_t j) const;
+
+    /**
+     * Widok przechowuje wskaznik na wektor, wiec nie moze powstac z wektora tymczasowego
+     * (takze z wyrazenia wektorowego)
+     */
+    void replace_column(DynamicVector<T>&& vector, size_t j) const = delete;
+
+    /**
+     * Tworzy widok na x-ty wiersz macierzy
+     * @param x
+     * @return widok
+     */
+    RowView<const DynamicMatrix<T>> row(size_t x) const;
+
+    /**
+     * Tworzy widok na y-ta kolumne macierzy
+     * @param y
+     * @return widok
+     */
+    ColumnView<const DynamicMatrix<T>> column(size_t y) const;
+
+    /**
+     * Operator mnozenia macierzy przez wektor
+     * @param vector
+     * @return wyrazenie wektorowe
+     */
+    MatrixVectorProduct<DynamicMatrix<T>, DynamicVector<T>> operator*(const DynamicVector<T>& vector) const;
+
+    /**
+     * Operator mnozenia macierzy przez wyrazenie wektorowe (np. widok wiersza lub kolumny)
+     * @param expression
+     * @return wyrazenie wektorowe
+     */
+    template <class E>
+    MatrixVectorProduct<DynamicMatrix<T>, E> operator*(const VectorExpression<E>& expression) const;
+
+    /**
+     * Operator indeksowania macierzy ze sprawdzaniem granic
+     * @param x
+     * @param y
+     * @return skalar na (x, y)-tej pozycji w macierzy
+     */
+    T operator()(size_t x, size_t y) const;
+
+    /**
+     * Operator indeksowania macierzy ze sprawdzaniem granic
+     * @param x
+     * @param y
+     * @return referencja na skalar na (x, y)-tej pozycji w macierzy
+     */
+    T& operator()(size_t x, size_t y);
+
+    /**
+     * Operator indeksowania macierzy
+     * @param x
+     * @return wskaznik na poczatek x-tego wiersza
+     */
+    const T* operator[](size_t x) const;
+
+    /**
+     * Operator indeksowania macierzy
+     * @param x
+     * @return wskaznik na poczatek x-tego wiersza
+     */
+    T* operator[](size_t x);
+
+    /* niezalezna templatka, zeby uniknac problemow kompilacji */
+
+    /**
+     * Przeladowany operator wejscia, dla macierzy pustej rozmiar macierzy kwadratowej
+     * wyznacza liczba skalarow w pierwszym wierszu
+     * @param in
+     * @param matrix
+     */
+    template <class _T>
+    friend std::istream& operator>>(std::istream& in, DynamicMatrix<_T>& matrix);
+
+    /**
+     * Przeladowany operator wyjscia
+     * @param out
+     * @param matrix
+     */
+    template <class _T>
+    friend std::ostream& operator<<(std::ostream& out, const DynamicMatrix<_T>& matrix);
+
+private:
+    size_t rows_count = 0; /** Liczba wierszy */
+    size_t columns_count = 0; /** Liczba kolumn */
+    std::vector<T, AlignedAllocator<T>> scalars; /** Skalary zapisane wierszami */
+};
+
+template <class T>
+DynamicMatrix<T>::DynamicMatrix(const size_t rows, const size_t columns, T scalar)
+        : rows_count(rows), columns_count(columns), scalars(rows * columns, scalar) {}
+
+template <class T>
+template <class D>
+DynamicMatrix<T>::DynamicMatrix(const MatrixView<D>& view)
+        : DynamicMatrix(view.derived().rows(), view.derived().columns()) {
+    const D& matrix = view.derived();
+    for (size_t x = 0; x < rows_count; x++) {
+        const auto row = matrix[x];
+        for (size_t y = 0; y < columns_count; y++)
+            (*this)[x][y] = row[y];
+    }
+}
+
+template <class T>
+size_t DynamicMatrix<T>::rows() const {
+    return rows_count;
+}
+
+template <class T>
+size_t DynamicMatrix<T>::columns() const {
+    return columns_count;
+}
+
+template <class T>
+const T* DynamicMatrix<T>::data() const {
+    return scalars.data();
+}
+
+template <class T>
+T* DynamicMatrix<T>::data() {
+    return scalars.data();
+}
+
+template <class T>
+T DynamicMatrix<T>::det() const {
+    if (rows_count != columns_count)
+        throw std::runtime_error("Matrix is not square");
+
+    DynamicMatrix<T> result = *this;
+    return Factorization<T>::eliminate(result, rows_count);
+}
+
+template <class T>
+DynamicMatrix<T> DynamicMatrix<T>::transpose() const {
+    DynamicMatrix<T> result(columns_count, rows_count);
+    for (size_t x = 0; x < columns_count; x++)
+        for (size_t y = 0; y < rows_count; y++)
+            result[x][y] = (*this)[y][x];
+    return result;
+}
+
+template <class T>
+TransposedView<const DynamicMatrix<T>> DynamicMatrix<T>::transposed() const {
+    return TransposedView<const DynamicMatrix<T>>(*this);
+}
+
+template <class T>
+ReplacedColumnView<DynamicMatrix<T>, DynamicVector<T>> DynamicMatrix<T>::replace_column(const DynamicVector<T> &vector, const size_t j) const {
+    if (vector.length() != rows_count)
+        throw std::runtime_error("Size mismatch");
+    if (j >= columns_count)
+        throw std::runtime_error("Index out of range");
+
+    return ReplacedColumnView<DynamicMatrix<T>, DynamicVector<T>>(*this, vector, j);
+}
+
+template <class T>
+RowView<const DynamicMatrix<T>> DynamicMatrix<T>::row(const size_t x) const {
+    if (x >= rows_count)
+        throw std::runtime_error("Index out of range");
+    return RowView<const DynamicMatrix<T>>(*this, x);
+}
+
+template <class T>
+ColumnView<const DynamicMatrix<T>> DynamicMatrix<T>::column(const size_t y) const {
+    if (y >= columns_count)
+        throw std::runtime_error("Index out of range");
+    return ColumnView<const DynamicMatrix<T>>(*this, y);
+}
+
+template <class T>
+MatrixVectorProduct<DynamicMatrix<T>, DynamicVector<T>> DynamicMatrix<T>::operator*(const DynamicVector<T> &vector) const {
+    return MatrixVectorProduct<DynamicMatrix<T>, DynamicVector<T>>(*this, vector);
+}
+
+template <class T>
+template <class E>
+MatrixVectorProduct<DynamicMatrix<T>, E> DynamicMatrix<T>::operator*(const VectorExpression<E>& expression) const {
+    return MatrixVectorProduct<DynamicMatrix<T>, E>(*this, expression.derived());
+}
+
+template <class T>
+T DynamicMatrix<T>::operator()(const size_t x, const size_t y) const {
+    if (x >= rows_count || y >= columns_count)
+        throw std::runtime_error("Index out of range");
+    return scalars[x * columns_count + y];
+}
+
+template <class T>
+T& DynamicMatrix<T>::operator()(const size_t x, const size_t y) {
+    if (x >= rows_count || y >= columns_count)
+        throw std::runtime_error("Index out of range");
+    return scalars[x * columns_count + y];
+}
+
+template <class T>
+const T* DynamicMatrix<T>::operator[](const size_t x) const {
+    return scalars.data() + x * columns_count;
+}
+
+template <class T>
+T* DynamicMatrix<T>::operator[](const size_t x) {
+    return scalars.data() + x * columns_count;
+}
+
+template <class T>
+std::istream& operator>>(std::istream& in, DynamicMatrix<T>& matrix) {
+    size_t x = 0;
+
+    if (matrix.rows_count == 0) {
+        std::vector<T> first_row;
+        if (!read_row(in, first_row))
+            return in;
+
+        matrix = DynamicMatrix<T>(first_row.size(), first_row.size());
+        for (size_t y = 0; y < first_row.size(); y++)
+            matrix[0][y] = first_row[y];
+        x = 1;
+    }
+
+    for (; x < matrix.rows_count; x++)
+        for (size_t y = 0; y < matrix.columns_count; y++)
+            in >> matrix[x][y];
+    return in;
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, const DynamicMatrix<T>& matrix) {
+    for (size_t x = 0; x < matrix.rows_count; x++) {
+        for (size_t y = 0; y < matrix.columns_count; y++) {
+            out << matrix[x][y];
+            if (y < matrix.columns_count - 1)
+                out << " ";
+        }
+        if (x < matrix.rows_count - 1)
+            out << "\n";
+    }
+    return out;
+}
+
+/**
+ * Specjalizacja cechy Resizable dla macierzy o rozmiarze ustalanym w czasie wykonania
+ * @tparam T
+ */
+template <class T>
+struct Resizable<DynamicMatrix<T>> : std::true_type {};
+
+/**
+ * Macierze sa argumentami wyrazen przechowywanymi przez referencje
+ * @tparam T
+ */
+template <class T>
+struct ExpressionOperand<DynamicMatrix<T>> {
+    using type = const DynamicMatrix<T>&;
+};
+
+/**
+ * Iloczyn macierzy przez wektor liczony w calosci jadrem matvec (cztery wiersze naraz)
+ * @tparam T
+ */
+template <class T>
+struct ExpressionEvaluator<MatrixVectorProduct<DynamicMatrix<T>, DynamicVector<T>>> {
+    static void evaluate(const MatrixVectorProduct<DynamicMatrix<T>, DynamicVector<T>>& product, T* result) {
+        const DynamicMatrix<T>& matrix = product.matrix();
+        Kernels<T>::matvec(matrix.data(), matrix.columns(), product.vector().data(), result, matrix.rows(), matrix.columns());
+    }
+};
+
+using DynamicMatrixd = DynamicMatrix<double>; /** Alias dla macierzy liczb rzeczywistych */
+using DynamicMatrixc = DynamicMatrix<Complex<double>>; /** Alias dla macierzy liczb zespolonych */
+
+#endif //ZAD3_DYNAMICMATRIX_HH
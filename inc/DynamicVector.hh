@@ -0,0 +1,240 @@
+#ifndef ZAD3_DYNAMICVECTOR_HH
+#define ZAD3_DYNAMICVECTOR_HH
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Complex.hh"
+#include "../inc/AlignedAllocator.hh"
+#include "../inc/VectorExpression.hh"
+
+/**
+ * Klasa reprezentujaca wektor o skalarach T i rozmiarze ustalanym w czasie wykonania,
+ * przechowywany w ciaglej, wyrownanej pamieci na stercie
+ * @tparam T
+ */
+template <class T>
+class DynamicVector : public VectorExpression<DynamicVector<T>> {
+
+public:
+    using scalar_type = T; /** Typ skalara */
+
+    /**
+     * Tworzy wektor o podanej dlugosci i wszystkich skalarach rownych podanemu
+     * @param length
+     * @param scalar
+     */
+    explicit DynamicVector(size_t length, T scalar = T());
+
+    /**
+     * Tworzy wektor pusty
+     */
+    DynamicVector() = default;
+
+    /**
+     * Tworzy wektor wyliczajac wyrazenie wektorowe
+     * @param expression
+     */
+    template <class E>
+    DynamicVector(const VectorExpression<E>& expression);
+
+    /**
+     * Operator przypisania wyrazenia wektorowego, jedyne miejsce zapisu skalarow wyrazenia
+     * @param expression
+     * @return referencja na wektor
+     */
+    template <class E>
+    DynamicVector<T>& operator=(const VectorExpression<E>& expression);
+
+    /**
+     * Zwraca dlugosc wektora
+     * @return dlugosc
+     */
+    size_t length() const;
+
+    /**
+     * Zwraca wskaznik na poczatek danych
+     * @return wskaznik
+     */
+    const T* data() const;
+
+    /**
+     * Zwraca wskaznik na poczatek danych
+     * @return wskaznik
+     */
+    T* data();
+
+    /* operatory arytmetyczne (+, -, *, /) tworza wyrazenia wektorowe z VectorExpression.hh */
+
+    /**
+     * Wylicza iloczyn skalarny
+     * @param vector
+     * @return wartosc
+     */
+    T dot(const DynamicVector<T>& vector) const;
+
+    using VectorExpression<DynamicVector<T>>::dot; /** Iloczyn skalarny z dowolnym wyrazeniem (np. widokiem wiersza) */
+
+    /**
+     * Operator indeksowania wektora
+     * @param i
+     * @return skalar na i-tej pozycji w wektorze
+     */
+    T operator[](size_t i) const;
+
+    /**
+     * Operator indeksowania wektora
+     * @param i
+     * @return referencje na skalar na i-tej pozycji w wektorze
+     */
+    T& operator[](size_t i);
+
+    /**
+     * Operator indeksowania wektora ze sprawdzaniem granic
+     * @param i
+     * @return skalar na i-tej pozycji w wektorze
+     */
+    T operator()(size_t i) const;
+
+    /**
+     * Operator indeksowania wektora ze sprawdzaniem granic
+     * @param i
+     * @return referencje na skalar na i-tej pozycji w wektorze
+     */
+    T& operator()(size_t i);
+
+    /* niezalezna templatka, zeby uniknac problemow kompilacji */
+
+    /**
+     * Przeladowany operator wejscia, wczytuje tyle skalarow, ile wynosi dlugosc wektora
+     * @param in
+     * @param vector
+     */
+    template <typename _T>
+    friend std::istream& operator>>(std::istream& in, DynamicVector<_T>& vector);
+
+    /**
+     * Przeladowany operator wyjscia
+     * @param in
+     * @param vector
+     */
+    template <typename _T>
+    friend std::ostream& operator<<(std::ostream& out, const DynamicVector<_T>& vector);
+
+private:
+    std::vector<T, AlignedAllocator<T>> scalars;
+};
+
+template <class T>
+DynamicVector<T>::DynamicVector(const size_t length, T scalar) : scalars(length, scalar) {}
+
+template <class T>
+template <class E>
+DynamicVector<T>::DynamicVector(const VectorExpression<E>& expression) : scalars(expression.derived().length()) {
+    ExpressionEvaluator<E>::evaluate(expression.derived(), scalars.data());
+}
+
+template <class T>
+template <class E>
+DynamicVector<T>& DynamicVector<T>::operator=(const VectorExpression<E>& expression) {
+    const E& vector = expression.derived();
+
+    if (ExpressionOperand<E>::aliases(vector, scalars.data())) {
+        *this = DynamicVector<T>(expression);
+        return *this;
+    }
+
+    scalars.resize(vector.length());
+    ExpressionEvaluator<E>::evaluate(vector, scalars.data());
+    return *this;
+}
+
+template <class T>
+size_t DynamicVector<T>::length() const {
+    return scalars.size();
+}
+
+template <class T>
+const T* DynamicVector<T>::data() const {
+    return scalars.data();
+}
+
+template <class T>
+T* DynamicVector<T>::data() {
+    return scalars.data();
+}
+
+template <class T>
+T DynamicVector<T>::dot(const DynamicVector<T>& vector) const {
+    if (vector.length() != length())
+        throw std::runtime_error("Size mismatch");
+
+    return Kernels<T>::dot(scalars.data(), vector.scalars.data(), length());
+}
+
+template <class T>
+T DynamicVector<T>::operator[](const size_t i) const {
+    return scalars[i];
+}
+
+template <class T>
+T& DynamicVector<T>::operator[](const size_t i) {
+    return scalars[i];
+}
+
+template <class T>
+T DynamicVector<T>::operator()(const size_t i) const {
+    if (i >= length())
+        throw std::runtime_error("Index out of range");
+    return scalars[i];
+}
+
+template <class T>
+T& DynamicVector<T>::operator()(const size_t i) {
+    if (i >= length())
+        throw std::runtime_error("Index out of range");
+    return scalars[i];
+}
+
+template <class T>
+std::istream& operator>>(std::istream& in, DynamicVector<T>& vector) {
+    for (size_t i = 0; i < vector.length(); i++)
+        in >> vector.scalars[i];
+    return in;
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, const DynamicVector<T>& vector) {
+    for (size_t i = 0; i < vector.length(); i++) {
+        out << vector.scalars[i];
+        if (i < vector.length() - 1)
+            out << " ";
+    }
+    return out;
+}
+
+/**
+ * Wektory przechowuja skalary w ciaglej pamieci
+ * @tparam T
+ */
+template <class T>
+struct Contiguous<DynamicVector<T>> : std::true_type {};
+
+/**
+ * Wektory sa argumentami wyrazen przechowywanymi przez referencje
+ * @tparam T
+ */
+template <class T>
+struct ExpressionOperand<DynamicVector<T>> {
+    using type = const DynamicVector<T>&;
+
+    static bool aliases(const DynamicVector<T>&, const void*) {
+        return false;
+    }
+};
+
+using DynamicVectord = DynamicVector<double>; /** Alias dla wektora liczb rzeczywistych */
+using DynamicVectorc = DynamicVector<Complex<double>>; /** Alias dla wektora liczb zespolonych */
+
+#endif //ZAD3_DYNAMICVECTOR_HH
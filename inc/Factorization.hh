@@ -0,0 +1,207 @@
+#ifndef ZAD3_FACTORIZATION_HH
+#define ZAD3_FACTORIZATION_HH
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../inc/Complex.hh"
+#include "../inc/Scalar.hh"
+#include "../inc/Kernels.hh"
+
+/**
+ * Algorytmy eliminacji Gaussa i rozkladu LU niezalezne od sposobu przechowywania macierzy,
+ * wymagaja jedynie indeksowania matrix[x][y] oraz vector[x]
+ * @tparam T
+ */
+template <class T>
+struct Factorization {
+    /**
+     * Wybiera element glowny w k-tej kolumnie ponizej przekatnej
+     * @param matrix
+     * @param n
+     * @param k
+     * @return indeks wiersza o najwiekszym module
+     */
+    template <class M>
+    static constexpr size_t pivot(const M& matrix, const size_t n, const size_t k) {
+        size_t result = k;
+        auto result_magnitude = Scalar<T>::magnitude(matrix[k][k]);
+        for (size_t x = k + 1; x < n; x++) {
+            const auto magnitude = Scalar<T>::magnitude(matrix[x][k]);
+            if (magnitude > result_magnitude) {
+                result = x;
+                result_magnitude = magnitude;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Zamienia wiersze a i b od kolumny from (std::swap nie jest constexpr w C++17)
+     * @param matrix
+     * @param n
+     * @param a
+     * @param b
+     * @param from
+     */
+    template <class M>
+    static constexpr void swap_rows(M& matrix, const size_t n, const size_t a, const size_t b, const size_t from = 0) {
+        for (size_t y = from; y < n; y++) {
+            const T scalar = matrix[a][y];
+            matrix[a][y] = matrix[b][y];
+            matrix[b][y] = scalar;
+        }
+    }
+
+    /**
+     * Odejmuje od x-tego wiersza k-ty pomnozony przez factor (od kolumny k + 1)
+     * @param matrix
+     * @param n
+     * @param k
+     * @param x
+     * @param factor
+     */
+    template <class M>
+    static constexpr void update_row(M& matrix, const size_t n, const size_t k, const size_t x, const T factor) {
+        /* wiersze ciagle w pamieci (DynamicMatrix) - jadro axpy */
+        if constexpr (std::is_pointer<std::decay_t<decltype(matrix[k])>>::value) {
+            Kernels<T>::axpy(T(0) - factor, matrix[k] + k + 1, matrix[x] + k + 1, n - k - 1);
+        } else {
+            for (size_t y = k + 1; y < n; y++)
+                matrix[x][y] -= factor * matrix[k][y];
+        }
+    }
+
+    /**
+     * Sprowadza macierz w miejscu do postaci trojkatnej gornej
+     * @param matrix
+     * @param n
+     * @return wyznacznik macierzy
+     */
+    template <class M>
+    static constexpr T eliminate(M& matrix, const size_t n) {
+        bool odd = false;
+
+        for (size_t k = 0; k < n; k++) {
+            const size_t x_pivot = pivot(matrix, n, k);
+
+            if (Scalar<T>::magnitude(matrix[x_pivot][k]) == 0)
+                return T(0);
+
+            if (x_pivot != k) {
+                swap_rows(matrix, n, k, x_pivot, k);
+                odd = !odd;
+            }
+
+            for (size_t x = k + 1; x < n; x++)
+                update_row(matrix, n, k, x, matrix[x][k] / matrix[k][k]);
+        }
+
+        return det(matrix, n, odd);
+    }
+
+    /**
+     * Rozklada macierz w miejscu na L (pod przekatna, jedynki na przekatnej pominiete) i U,
+     * z czesciowym wyborem elementu glownego
+     * @param matrix
+     * @param n
+     * @param permutation permutation[i] - indeks wiersza wejsciowego na i-tej pozycji
+     * @return true jesli permutacja jest nieparzysta
+     */
+    template <class M>
+    static bool decompose(M& matrix, const size_t n, size_t* permutation) {
+        bool odd = false;
+
+        for (size_t i = 0; i < n; i++)
+            permutation[i] = i;
+
+        for (size_t k = 0; k < n; k++) {
+            const size_t x_pivot = pivot(matrix, n, k);
+
+            if (Scalar<T>::magnitude(matrix[x_pivot][k]) == 0)
+                throw std::runtime_error("Singular matrix");
+
+            if (x_pivot != k) {
+                swap_rows(matrix, n, k, x_pivot);
+                const size_t index = permutation[k];
+                permutation[k] = permutation[x_pivot];
+                permutation[x_pivot] = index;
+                odd = !odd;
+            }
+
+            for (size_t x = k + 1; x < n; x++) {
+                const T factor = matrix[x][k] / matrix[k][k];
+                matrix[x][k] = factor;
+                update_row(matrix, n, k, x, factor);
+            }
+        }
+
+        return odd;
+    }
+
+    /**
+     * Rozwiazuje w miejscu LUx = b, wektor musi byc juz spermutowany
+     * @param factors
+     * @param n
+     * @param vector
+     */
+    template <class M, class V>
+    static void substitute(const M& factors, const size_t n, V& vector) {
+        for (size_t x = 1; x < n; x++)
+            for (size_t y = 0; y < x; y++)
+                vector[x] -= factors[x][y] * vector[y];
+
+        for (size_t x = n; x-- > 0;) {
+            for (size_t y = x + 1; y < n; y++)
+                vector[x] -= factors[x][y] * vector[y];
+            vector[x] = vector[x] / factors[x][x];
+        }
+    }
+
+    /**
+     * Rozwiazuje w miejscu LUX = B dla bloku prawych stron (kolumny B to kolejne wektory b, wiersze
+     * ciagle w pamieci i juz spermutowane); kazdy krok podstawienia to axpy na wierszu B, a kolumny
+     * przetwarzane sa pasami, zeby wiersze pasa miescily sie w cache
+     * @param factors
+     * @param n
+     * @param block
+     */
+    template <class M, class B>
+    static void substitute_block(const M& factors, const size_t n, B& block) {
+        const size_t columns = block.columns();
+
+        for (size_t from = 0; from < columns; from += block_columns) {
+            const size_t width = columns - from < block_columns ? columns - from : block_columns;
+
+            for (size_t x = 1; x < n; x++)
+                for (size_t y = 0; y < x; y++)
+                    Kernels<T>::axpy(T(0) - factors[x][y], block[y] + from, block[x] + from, width);
+
+            for (size_t x = n; x-- > 0;) {
+                for (size_t y = x + 1; y < n; y++)
+                    Kernels<T>::axpy(T(0) - factors[x][y], block[y] + from, block[x] + from, width);
+                Kernels<T>::scale(T(1) / factors[x][x], block[x] + from, width);
+            }
+        }
+    }
+
+    static constexpr size_t block_columns = 256; /** Szerokosc pasa kolumn w substitute_block */
+
+    /**
+     * Wylicza wyznacznik z przekatnej macierzy trojkatnej
+     * @param factors
+     * @param n
+     * @param odd
+     * @return wartosc
+     */
+    template <class M>
+    static constexpr T det(const M& factors, const size_t n, const bool odd) {
+        T result = 1;
+        for (size_t i = 0; i < n; i++)
+            result = result * factors[i][i];
+        return odd ? T(0) - result : result;
+    }
+};
+
+#endif //ZAD3_FACTORIZATION_HH
@@ -0,0 +1,252 @@
+#ifndef ZAD3_FIXEDSOLVER_HH
+#define ZAD3_FIXEDSOLVER_HH
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../inc/Scalar.hh"
+#include "../inc/Kernels.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/LUDecomposition.hh"
+#include "../inc/Instrumentation.hh"
+
+/**
+ * Wywoluje function(std::integral_constant<size_t, i>) dla i = begin, ..., end - 1, rozwijajac petle
+ * w czasie kompilacji; funkcja i przekazywane lambdy sa always_inline, bo bez tego GCC przy wiekszych
+ * ukladach nie wkleja zewnetrznych krokow i tablice z ukladem trafiaja z rejestrow do pamieci
+ * @tparam begin
+ * @tparam end
+ * @tparam F
+ * @param function
+ */
+template <size_t begin, size_t end, class F>
+__attribute__((always_inline)) constexpr void unroll(F&& function) {
+    if constexpr (begin < end) {
+        function(std::integral_constant<size_t, begin>());
+        unroll<begin + 1, end>(function);
+    }
+}
+
+/**
+ * Eliminacja Gaussa dla ukladu o rozmiarze n ustalonym w czasie kompilacji: wszystkie petle sa
+ * rozwiniete, uklad (wiersze macierzy z dopisanym skalarem b) jest zmienna lokalna, ktora kompilator
+ * trzyma w rejestrach, a wybor elementu glownego to warunkowe zamiany wierszy zamiast skokow
+ * @tparam T
+ * @tparam n
+ */
+template <class T, size_t n>
+struct FixedSolver {
+    static_assert(n > 0, "Empty system");
+
+    /**
+     * Rozwiazuje uklad Ax = b z czesciowym wyborem elementu glownego
+     * @tparam M
+     * @tparam V
+     * @param matrix macierz indeksowana matrix[x][y]
+     * @param vector wektor indeksowany vector[x]
+     * @return rozwiazanie
+     */
+    template <class M, class V>
+    static constexpr std::array<T, n> solve(const M& matrix, const V& vector);
+
+    /**
+     * Rozwiazuje uklad jak solve(matrix, vector) i zapisuje rozwiazanie do wektora
+     * @tparam M
+     * @tparam V
+     * @tparam R
+     * @param matrix
+     * @param vector
+     * @param result wektor o dlugosci n indeksowany result[x]
+     */
+    template <class M, class V, class R>
+    static constexpr void solve(const M& matrix, const V& vector, R& result) {
+        const std::array<T, n> solution = solve(matrix, vector);
+        for (size_t i = 0; i < n; i++)
+            result[i] = solution[i];
+    }
+};
+
+template <class T, size_t n>
+template <class M, class V>
+constexpr std::array<T, n> FixedSolver<T, n>::solve(const M& matrix, const V& vector) {
+    std::array<std::array<T, n + 1>, n> rows{};
+    unroll<0, n>([&](auto x) __attribute__((always_inline)) {
+        unroll<0, n>([&](auto y) __attribute__((always_inline)) {
+            rows[x][y] = matrix[x][y];
+        });
+        rows[x][n] = vector[x];
+    });
+
+    std::array<T, n> inverses{};
+    bool singular = false;
+#ifdef ZAD3_INSTRUMENTATION
+    /* numery wierszy poczatkowego ukladu na kolejnych pozycjach, do statystyk elementow glownych */
+    std::array<size_t, n> order{};
+    for (size_t i = 0; i < n; i++)
+        order[i] = i;
+#endif
+
+    {
+        ZAD3_PHASE(Phase::factorization, Cost<T>::factorization(n), n * (n + 1) * sizeof(T));
+        unroll<0, n>([&](auto k) __attribute__((always_inline)) {
+            /* wiersz elementu glownego wybierany porownaniami skalarow, a zamiana wierszy to wybor
+             * warunkowy w kazdym wierszu ponizej k, bez skokow i bez indeksowania zmienna */
+            size_t pivot = k;
+            auto pivot_magnitude = Scalar<T>::magnitude(rows[k][k]);
+            unroll<k + 1, n>([&](auto x) __attribute__((always_inline)) {
+                const auto magnitude = Scalar<T>::magnitude(rows[x][k]);
+                const bool larger = magnitude > pivot_magnitude;
+                pivot = larger ? x : pivot;
+                pivot_magnitude = larger ? magnitude : pivot_magnitude;
+            });
+
+            const std::array<T, n + 1> upper = rows[k];
+            unroll<k + 1, n>([&](auto x) __attribute__((always_inline)) {
+                const bool chosen = pivot == x;
+                unroll<k, n + 1>([&](auto y) __attribute__((always_inline)) {
+                    rows[k][y] = chosen ? rows[x][y] : rows[k][y];
+                    rows[x][y] = chosen ? upper[y] : rows[x][y];
+                });
+            });
+#ifdef ZAD3_INSTRUMENTATION
+            std::swap(order[k], order[pivot]);
+#endif
+
+            singular |= Scalar<T>::magnitude(rows[k][k]) == 0;
+            inverses[k] = T(1) / rows[k][k];
+
+            unroll<k + 1, n>([&](auto x) __attribute__((always_inline)) {
+                const T factor = rows[x][k] * inverses[k];
+                unroll<k + 1, n + 1>([&](auto y) __attribute__((always_inline)) {
+                    rows[x][y] -= factor * rows[k][y];
+                });
+            });
+        });
+    }
+
+    if (singular)
+        throw std::runtime_error("Singular matrix");
+    ZAD3_PIVOTS(rows, n, order.data());
+
+    ZAD3_PHASE(Phase::substitution, Cost<T>::product(n), n * (n + 1) * sizeof(T));
+    std::array<T, n> result{};
+    unroll<0, n>([&](auto i) __attribute__((always_inline)) {
+        constexpr size_t k = n - 1 - i;
+        T sum = rows[k][n];
+        unroll<k + 1, n>([&](auto y) __attribute__((always_inline)) {
+            sum -= rows[k][y] * result[y];
+        });
+        result[k] = sum * inverses[k];
+    });
+    return result;
+}
+
+/**
+ * Najwiekszy rozmiar ukladu rozwiazywanego przez FixedSolver
+ */
+constexpr size_t fixed_solver_limit = 8;
+
+/**
+ * Rozwiazuje uklad o rozmiarze znanym dopiero w czasie wykonania: dla n do fixed_solver_limit wybiera
+ * odpowiednia instancje FixedSolver, dla wiekszych rozklada macierz przez DynamicLUDecomposition
+ * @tparam T
+ * @param matrix
+ * @param vector
+ * @param result rozwiazanie (wektor o dlugosci n jest zapisywany bez ponownej alokacji)
+ */
+template <class T>
+void solve_fixed(const DynamicMatrix<T>& matrix, const DynamicVector<T>& vector, DynamicVector<T>& result) {
+    const size_t n = matrix.rows();
+    if (matrix.columns() != n)
+        throw std::runtime_error("Matrix is not square");
+    if (vector.length() != n)
+        throw std::runtime_error("Size mismatch");
+
+    if (n == 0 || n > fixed_solver_limit) {
+        result = DynamicLUDecomposition<T>(matrix).solve(vector);
+        return;
+    }
+
+    if (result.length() != n)
+        result = DynamicVector<T>(n);
+
+    /* switch kompilowany jest do tablicy skokow, wiec wybor instancji kosztuje jeden skok posredni */
+    switch (n) {
+        case 1:
+            FixedSolver<T, 1>::solve(matrix, vector, result);
+            break;
+        case 2:
+            FixedSolver<T, 2>::solve(matrix, vector, result);
+            break;
+        case 3:
+            FixedSolver<T, 3>::solve(matrix, vector, result);
+            break;
+        case 4:
+            FixedSolver<T, 4>::solve(matrix, vector, result);
+            break;
+        case 5:
+            FixedSolver<T, 5>::solve(matrix, vector, result);
+            break;
+        case 6:
+            FixedSolver<T, 6>::solve(matrix, vector, result);
+            break;
+        case 7:
+            FixedSolver<T, 7>::solve(matrix, vector, result);
+            break;
+        default:
+            FixedSolver<T, 8>::solve(matrix, vector, result);
+    }
+}
+
+/**
+ * @see solve_fixed(const DynamicMatrix<T>&, const DynamicVector<T>&, DynamicVector<T>&)
+ * @return rozwiazanie
+ */
+template <class T>
+DynamicVector<T> solve_fixed(const DynamicMatrix<T>& matrix, const DynamicVector<T>& vector) {
+    DynamicVector<T> result;
+    solve_fixed(matrix, vector, result);
+    return result;
+}
+
+/**
+ * Wylicza wektor bledu Ax-b: dla n do fixed_solver_limit iloczyny sumowane sa bez fma w kolejnosci jader
+ * lane_residual i complex_lane_residual (SimdKernels.hh) - dla liczb rzeczywistych po kolei, dla zespolonych
+ * w dwoch sumach jak ogolne Kernels::dot - wiec blad nie zalezy od zestawu instrukcji i jest taki sam
+ * w --batch; dla wiekszych jak matrix * solution - vector
+ * @tparam T
+ * @param matrix
+ * @param vector
+ * @param solution
+ * @param error wektor bledu (wektor o dlugosci n jest zapisywany bez ponownej alokacji)
+ */
+template <class T>
+void residual_fixed(const DynamicMatrix<T>& matrix, const DynamicVector<T>& vector, const DynamicVector<T>& solution,
+                    DynamicVector<T>& error) {
+    const size_t n = matrix.rows();
+    if (n == 0 || n > fixed_solver_limit) {
+        error = matrix * solution - vector;
+        return;
+    }
+
+    if (error.length() != n)
+        error = DynamicVector<T>(n);
+
+    for (size_t x = 0; x < n; x++) {
+        const T* row = matrix[x];
+        if constexpr (Scalar<T>::complex) {
+            error[x] = Kernels<T>::dot(row, solution.data(), n) - vector[x];
+        } else {
+            T sum = 0;
+            for (size_t y = 0; y < n; y++)
+                sum += row[y] * solution[y];
+            error[x] = sum - vector[x];
+        }
+    }
+}
+
+#endif //ZAD3_FIXEDSOLVER_HH
@@ -0,0 +1,168 @@
+#ifndef ZAD3_INSTRUMENTATION_HH
+#define ZAD3_INSTRUMENTATION_HH
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../inc/Scalar.hh"
+
+/* pomiary etapow rozwiazania wlaczane opcja ZAD3_INSTRUMENTATION w CMake; bez niej makra ZAD3_PHASE,
+ * ZAD3_BYTES i ZAD3_PIVOTS rozwijaja sie do pustych instrukcji, a ich argumenty nie sa nawet wyliczane */
+
+/**
+ * Mierzone etapy
+ */
+enum class Phase {
+    parse, /** Wczytanie ukladu z tekstu */
+    load, /** Kopiowanie ukladu z pliku binarnego */
+    factorization, /** Rozklad LU */
+    substitution, /** Podstawienie w przod i wstecz */
+    residual, /** Wektor bledu Ax-b */
+    output, /** Wypisanie rozwiazania */
+    count /** Liczba etapow */
+};
+
+/**
+ * Liczniki zbierane przez caly czas dzialania programu; zapisywane atomowo, wiec etapy moga byc
+ * mierzone rownoczesnie na watkach puli
+ */
+class Instrumentation {
+public:
+    /**
+     * Dolicza jedno wykonanie etapu
+     * @param phase
+     * @param nanoseconds czas
+     * @param flops liczba dzialan zmiennoprzecinkowych (szacowana)
+     * @param bytes liczba przetworzonych bajtow
+     */
+    static void record(Phase phase, uint64_t nanoseconds, uint64_t flops, uint64_t bytes);
+
+    /**
+     * Dolicza elementy glowne rozkladu: najmniejszy i najwiekszy modul oraz liczbe przestawionych wierszy
+     * @param smallest
+     * @param largest
+     * @param count liczba elementow glownych
+     * @param moved liczba wierszy poza swoja pozycja
+     */
+    static void record_pivots(double smallest, double largest, uint64_t count, uint64_t moved);
+
+    /**
+     * Zapisuje podsumowanie w formacie JSON do deskryptora; nie alokuje pamieci i uzywa tylko funkcji
+     * bezpiecznych w obsludze sygnalu
+     * @param descriptor
+     */
+    static void dump(int descriptor);
+
+    /**
+     * Zapisuje podsumowanie przy zakonczeniu programu i po sygnale SIGUSR1, do pliku wskazanego zmienna
+     * srodowiskowa ZAD3_INSTRUMENTATION_OUTPUT lub na standardowe wyjscie bledow
+     */
+    static void install();
+};
+
+/**
+ * Pomiar czasu etapu od utworzenia do zniszczenia obiektu
+ */
+class PhaseTimer {
+public:
+    /**
+     * Rozpoczyna pomiar
+     * @param phase
+     * @param flops
+     * @param bytes
+     */
+    PhaseTimer(const Phase phase, const uint64_t flops, const uint64_t bytes)
+            : phase(phase), flops(flops), bytes(bytes), start(std::chrono::steady_clock::now()) {}
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    /**
+     * Konczy pomiar i dolicza go do licznikow
+     */
+    ~PhaseTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        Instrumentation::record(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), flops, bytes);
+    }
+
+    /**
+     * Dolicza bajty znane dopiero po wykonaniu etapu
+     * @param count
+     */
+    void add_bytes(const uint64_t count) {
+        bytes += count;
+    }
+
+private:
+    Phase phase; /** Mierzony etap */
+    uint64_t flops; /** Liczba dzialan */
+    uint64_t bytes; /** Liczba bajtow */
+    std::chrono::steady_clock::time_point start; /** Poczatek pomiaru */
+};
+
+/**
+ * Szacowana liczba dzialan zmiennoprzecinkowych etapow dla skalarow T (dodawanie i mnozenie zespolone
+ * liczone jako odpowiednio 2 i 6 dzialan, wiec jedno mnozenie z dodaniem to 8 zamiast 2)
+ * @tparam T
+ */
+template <class T>
+struct Cost {
+    static constexpr uint64_t scale = Scalar<T>::complex ? 4 : 1; /** Dzialania na jedno dzialanie rzeczywiste */
+
+    /**
+     * Rozklad LU macierzy n x n
+     * @param n
+     * @return liczba dzialan
+     */
+    static constexpr uint64_t factorization(const uint64_t n) {
+        return scale * 2 * n * n * n / 3;
+    }
+
+    /**
+     * Podstawienie w przod i wstecz albo mnozenie macierzy n x n przez wektor
+     * @param n
+     * @return liczba dzialan
+     */
+    static constexpr uint64_t product(const uint64_t n) {
+        return scale * 2 * n * n;
+    }
+};
+
+/**
+ * Dolicza elementy glowne z przekatnej rozkladu (U w miejscu macierzy) i permutacji wierszy
+ * @tparam M
+ * @param factors
+ * @param n
+ * @param permutation
+ */
+template <class M>
+void record_pivots(const M& factors, const size_t n, const size_t* permutation) {
+    using T = std::decay_t<decltype(factors[0][0])>;
+    if (n == 0)
+        return;
+
+    double smallest = static_cast<double>(Scalar<T>::magnitude(factors[0][0]));
+    double largest = smallest;
+    uint64_t moved = 0;
+    for (size_t i = 0; i < n; i++) {
+        const double magnitude = static_cast<double>(Scalar<T>::magnitude(factors[i][i]));
+        smallest = magnitude < smallest ? magnitude : smallest;
+        largest = magnitude > largest ? magnitude : largest;
+        moved += permutation[i] != i;
+    }
+    Instrumentation::record_pivots(smallest, largest, n, moved);
+}
+
+#ifdef ZAD3_INSTRUMENTATION
+#define ZAD3_PHASE(phase, flops, bytes) PhaseTimer zad3_phase_timer(phase, flops, bytes)
+#define ZAD3_BYTES(count) zad3_phase_timer.add_bytes(count)
+#define ZAD3_PIVOTS(factors, n, permutation) record_pivots(factors, n, permutation)
+#else
+#define ZAD3_PHASE(phase, flops, bytes) static_cast<void>(0)
+#define ZAD3_BYTES(count) static_cast<void>(0)
+#define ZAD3_PIVOTS(factors, n, permutation) static_cast<void>(0)
+#endif
+
+#endif //ZAD3_INSTRUMENTATION_HH
@@ -0,0 +1,323 @@
+#ifndef ZAD3_KERNELS_HH
+#define ZAD3_KERNELS_HH
+
+#include <cstddef>
+
+#include "../inc/SimdKernels.hh"
+
+/**
+ * Podstawowe jadra obliczeniowe na ciaglych tablicach skalarow; wersja ogolna (np. dla liczb zespolonych)
+ * to zwykle petle, specjalizacje dla double i float sa jawnie wektoryzowane (src/Kernels.cc)
+ * @tparam T
+ */
+template <class T>
+struct Kernels {
+    static constexpr bool vectorized = false; /** Czy jadra uzywaja instrukcji SIMD */
+    static constexpr size_t lanes = KernelTable<T>::lanes; /** Liczba ukladow w lane_solve */
+
+    /**
+     * Wylicza iloczyn skalarny
+     * @param a
+     * @param b
+     * @param n
+     * @return wartosc
+     */
+    static T dot(const T* a, const T* b, const size_t n) {
+        T s0 = 0, s1 = 0;
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            s0 += a[i] * b[i];
+            s1 += a[i + 1] * b[i + 1];
+        }
+        if (i < n)
+            s0 += a[i] * b[i];
+        return s0 + s1;
+    }
+
+    /**
+     * Dodaje do y wektor x pomnozony przez alpha
+     * @param alpha
+     * @param x
+     * @param y
+     * @param n
+     */
+    static void axpy(const T& alpha, const T* x, T* y, const size_t n) {
+        for (size_t i = 0; i < n; i++)
+            y[i] += alpha * x[i];
+    }
+
+    /**
+     * Mnozy x przez alpha
+     * @param alpha
+     * @param x
+     * @param n
+     */
+    static void scale(const T& alpha, T* x, const size_t n) {
+        for (size_t i = 0; i < n; i++)
+            x[i] = x[i] * alpha;
+    }
+
+    /**
+     * Wylicza y = Ax dla macierzy zapisanej wierszami co stride skalarow
+     * @param matrix
+     * @param stride
+     * @param x
+     * @param y
+     * @param rows
+     * @param columns
+     */
+    static void matvec(const T* matrix, const size_t stride, const T* x, T* y, const size_t rows, const size_t columns) {
+        for (size_t r = 0; r < rows; r++)
+            y[r] = dot(matrix + r * stride, x, columns);
+    }
+
+    /**
+     * Wylicza C -= AB dla macierzy zapisanych wierszami co a_stride, b_stride i c_stride skalarow
+     * @param a macierz rows x depth
+     * @param a_stride
+     * @param b macierz depth x columns
+     * @param b_stride
+     * @param c macierz rows x columns
+     * @param c_stride
+     * @param rows
+     * @param columns
+     * @param depth
+     */
+    static void gemm_subtract(const T* a, const size_t a_stride, const T* b, const size_t b_stride,
+                              T* c, const size_t c_stride, const size_t rows, const size_t columns, const size_t depth) {
+        for (size_t i = 0; i < rows; i++) {
+            T* row = c + i * c_stride;
+            for (size_t p = 0; p < depth; p++) {
+                const T factor = a[i * a_stride + p];
+                const T* other = b + p * b_stride;
+                for (size_t j = 0; j < columns; j++)
+                    row[j] -= factor * other[j];
+            }
+        }
+    }
+
+    /* jadra dla liczb zespolonych zapisanych w osobnych tablicach czesci rzeczywistych i urojonych (T rzeczywiste) */
+
+    /**
+     * Wylicza zespolony iloczyn skalarny (bez sprzezenia)
+     * @param a_real
+     * @param a_imaginary
+     * @param b_real
+     * @param b_imaginary
+     * @param n
+     * @param real czesc rzeczywista wyniku
+     * @param imaginary czesc urojona wyniku
+     */
+    static void complex_dot(const T* a_real, const T* a_imaginary, const T* b_real, const T* b_imaginary, const size_t n,
+                            T& real, T& imaginary) {
+        real = 0;
+        imaginary = 0;
+        for (size_t i = 0; i < n; i++) {
+            real += a_real[i] * b_real[i] - a_imaginary[i] * b_imaginary[i];
+            imaginary += a_real[i] * b_imaginary[i] + a_imaginary[i] * b_real[i];
+        }
+    }
+
+    /**
+     * Dodaje do y wektor x pomnozony przez zespolone alpha
+     */
+    static void complex_axpy(const T& alpha_real, const T& alpha_imaginary, const T* x_real, const T* x_imaginary,
+                             T* y_real, T* y_imaginary, const size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            y_real[i] += alpha_real * x_real[i] - alpha_imaginary * x_imaginary[i];
+            y_imaginary[i] += alpha_real * x_imaginary[i] + alpha_imaginary * x_real[i];
+        }
+    }
+
+    /**
+     * Mnozy po skladowych c = a * b
+     */
+    static void complex_multiply(const T* a_real, const T* a_imaginary, const T* b_real, const T* b_imaginary,
+                                 T* c_real, T* c_imaginary, const size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            const T real = a_real[i] * b_real[i] - a_imaginary[i] * b_imaginary[i];
+            c_imaginary[i] = a_real[i] * b_imaginary[i] + a_imaginary[i] * b_real[i];
+            c_real[i] = real;
+        }
+    }
+
+    /**
+     * Dzieli po skladowych c = a / b, mianownik to kwadrat modulu b
+     */
+    static void complex_divide(const T* a_real, const T* a_imaginary, const T* b_real, const T* b_imaginary,
+                               T* c_real, T* c_imaginary, const size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            const T norm = b_real[i] * b_real[i] + b_imaginary[i] * b_imaginary[i];
+            const T real = (a_real[i] * b_real[i] + a_imaginary[i] * b_imaginary[i]) / norm;
+            c_imaginary[i] = (a_imaginary[i] * b_real[i] - a_real[i] * b_imaginary[i]) / norm;
+            c_real[i] = real;
+        }
+    }
+
+    /**
+     * Wylicza y = Ax dla liczb zespolonych, czesci macierzy zapisane wierszami co stride skalarow
+     */
+    static void complex_matvec(const T* matrix_real, const T* matrix_imaginary, const size_t stride,
+                               const T* x_real, const T* x_imaginary, T* y_real, T* y_imaginary,
+                               const size_t rows, const size_t columns) {
+        for (size_t r = 0; r < rows; r++)
+            complex_dot(matrix_real + r * stride, matrix_imaginary + r * stride, x_real, x_imaginary, columns, y_real[r], y_imaginary[r]);
+    }
+
+    /**
+     * Rozwiazuje lanes ukladow o rozmiarze n <= lane_solver_limit zapisanych naprzemiennie (skalar (x, y)
+     * ukladu l pod indeksem (x * (n + 1) + y) * lanes + l, kolumna n to wyrazy wolne); wersja ogolna to
+     * to samo jadro z SimdKernels o szerokosci jednego skalara
+     * @param system
+     * @param n
+     * @param solution rozwiazania, skladowa x ukladu l pod indeksem x * lanes + l
+     * @param pivots (n + 1) * lanes skalarow: moduly elementow glownych (k * lanes + l) i liczby wierszy
+     * poza swoja pozycja (n * lanes + l) albo nullptr
+     * @return maska bitowa ukladow osobliwych
+     */
+    static unsigned lane_solve(const T* system, const size_t n, T* solution, T* pivots) {
+        return SimdKernels<ScalarSimd<T>>::lane_solve(system, n, solution, pivots);
+    }
+
+    /**
+     * @see lane_solve, dla liczb zespolonych zapisanych w osobnych tablicach czesci
+     */
+    static unsigned complex_lane_solve(const T* system_real, const T* system_imaginary, const size_t n,
+                                       T* solution_real, T* solution_imaginary, T* pivots) {
+        return SimdKernels<ScalarSimd<T>>::complex_lane_solve(system_real, system_imaginary, n, solution_real, solution_imaginary, pivots);
+    }
+
+    /**
+     * Wylicza wektory bledu Ax-b ukladow rozwiazanych przez lane_solve
+     * @param system
+     * @param n
+     * @param solution
+     * @param error wektory bledu zapisane jak solution
+     */
+    static void lane_residual(const T* system, const size_t n, const T* solution, T* error) {
+        SimdKernels<ScalarSimd<T>>::lane_residual(system, n, solution, error);
+    }
+
+    /**
+     * @see lane_residual, dla liczb zespolonych zapisanych w osobnych tablicach czesci
+     */
+    static void complex_lane_residual(const T* system_real, const T* system_imaginary, const size_t n,
+                                      const T* solution_real, const T* solution_imaginary, T* error_real, T* error_imaginary) {
+        SimdKernels<ScalarSimd<T>>::complex_lane_residual(system_real, system_imaginary, n, solution_real, solution_imaginary,
+                                                          error_real, error_imaginary);
+    }
+};
+
+/**
+ * Specjalizacja dla double, implementacja wybiera SSE2/AVX2/AVX-512 przy pierwszym uzyciu
+ */
+template <>
+struct Kernels<double> {
+    static constexpr bool vectorized = true;
+    static constexpr size_t lanes = KernelTable<double>::lanes;
+
+    static double dot(const double* a, const double* b, size_t n);
+    static void axpy(double alpha, const double* x, double* y, size_t n);
+    static void scale(double alpha, double* x, size_t n);
+    static void matvec(const double* matrix, size_t stride, const double* x, double* y, size_t rows, size_t columns);
+    static void gemm_subtract(const double* a, size_t a_stride, const double* b, size_t b_stride, double* c, size_t c_stride,
+                              size_t rows, size_t columns, size_t depth);
+    static void complex_dot(const double* a_real, const double* a_imaginary, const double* b_real, const double* b_imaginary, size_t n,
+                            double& real, double& imaginary);
+    static void complex_axpy(double alpha_real, double alpha_imaginary, const double* x_real, const double* x_imaginary,
+                             double* y_real, double* y_imaginary, size_t n);
+    static void complex_multiply(const double* a_real, const double* a_imaginary, const double* b_real, const double* b_imaginary,
+                                 double* c_real, double* c_imaginary, size_t n);
+    static void complex_divide(const double* a_real, const double* a_imaginary, const double* b_real, const double* b_imaginary,
+                               double* c_real, double* c_imaginary, size_t n);
+    static void complex_matvec(const double* matrix_real, const double* matrix_imaginary, size_t stride,
+                               const double* x_real, const double* x_imaginary, double* y_real, double* y_imaginary,
+                               size_t rows, size_t columns);
+    static unsigned lane_solve(const double* system, size_t n, double* solution, double* pivots);
+    static unsigned complex_lane_solve(const double* system_real, const double* system_imaginary, size_t n,
+                                       double* solution_real, double* solution_imaginary, double* pivots);
+    static void lane_residual(const double* system, size_t n, const double* solution, double* error);
+    static void complex_lane_residual(const double* system_real, const double* system_imaginary, size_t n,
+                                      const double* solution_real, const double* solution_imaginary, double* error_real, double* error_imaginary);
+
+    /**
+     * Zwraca nazwe wybranego zestawu instrukcji
+     * @return nazwa
+     */
+    static const char* isa();
+
+    /**
+     * Zwraca liczbe zestawow instrukcji dostepnych w procesorze, od jader ogolnych do wybranego
+     * @return liczba wariantow
+     */
+    static size_t variants();
+
+    /**
+     * Zwraca jadra i-tego zestawu instrukcji, niezaleznie od wybranego (do porownywania wariantow w testach)
+     * @param i 0 <= i < variants()
+     * @param name nazwa zestawu instrukcji
+     * @return tablica jader
+     */
+    static KernelTable<double> variant(size_t i, const char*& name);
+};
+
+/**
+ * Specjalizacja dla float, implementacja wybiera SSE2/AVX2/AVX-512 przy pierwszym uzyciu
+ */
+template <>
+struct Kernels<float> {
+    static constexpr bool vectorized = true;
+    static constexpr size_t lanes = KernelTable<float>::lanes;
+
+    static float dot(const float* a, const float* b, size_t n);
+    static void axpy(float alpha, const float* x, float* y, size_t n);
+    static void scale(float alpha, float* x, size_t n);
+    static void matvec(const float* matrix, size_t stride, const float* x, float* y, size_t rows, size_t columns);
+    static void gemm_subtract(const float* a, size_t a_stride, const float* b, size_t b_stride, float* c, size_t c_stride,
+                              size_t rows, size_t columns, size_t depth);
+    static void complex_dot(const float* a_real, const float* a_imaginary, const float* b_real, const float* b_imaginary, size_t n,
+                            float& real, float& imaginary);
+    static void complex_axpy(float alpha_real, float alpha_imaginary, const float* x_real, const float* x_imaginary,
+                             float* y_real, float* y_imaginary, size_t n);
+    static void complex_multiply(const float* a_real, const float* a_imaginary, const float* b_real, const float* b_imaginary,
+                                 float* c_real, float* c_imaginary, size_t n);
+    static void complex_divide(const float* a_real, const float* a_imaginary, const float* b_real, const float* b_imaginary,
+                               float* c_real, float* c_imaginary, size_t n);
+    static void complex_matvec(const float* matrix_real, const float* matrix_imaginary, size_t stride,
+                               const float* x_real, const float* x_imaginary, float* y_real, float* y_imaginary,
+                               size_t rows, size_t columns);
+    static unsigned lane_solve(const float* system, size_t n, float* solution, float* pivots);
+    static unsigned complex_lane_solve(const float* system_real, const float* system_imaginary, size_t n,
+                                       float* solution_real, float* solution_imaginary, float* pivots);
+    static void lane_residual(const float* system, size_t n, const float* solution, float* error);
+    static void complex_lane_residual(const float* system_real, const float* system_imaginary, size_t n,
+                                      const float* solution_real, const float* solution_imaginary, float* error_real, float* error_imaginary);
+
+    /**
+     * Zwraca nazwe wybranego zestawu instrukcji
+     * @return nazwa
+     */
+    static const char* isa();
+
+    /**
+     * Zwraca liczbe zestawow instrukcji dostepnych w procesorze, od jader ogolnych do wybranego
+     * @return liczba wariantow
+     */
+    static size_t variants();
+
+    /**
+     * Zwraca jadra i-tego zestawu instrukcji, niezaleznie od wybranego (do porownywania wariantow w testach)
+     * @param i 0 <= i < variants()
+     * @param name nazwa zestawu instrukcji
+     * @return tablica jader
+     */
+    static KernelTable<float> variant(size_t i, const char*& name);
+};
+
+/**
+ * Minimalny rozmiar wektora o stalym rozmiarze, od ktorego oplaca sie wolac jadra SIMD
+ * zamiast petli rozwijanej przez kompilator
+ */
+constexpr size_t kernel_threshold = 16;
+
+#endif //ZAD3_KERNELS_HH
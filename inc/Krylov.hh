@@ -0,0 +1,399 @@
+#ifndef ZAD3_KRYLOV_HH
+#define ZAD3_KRYLOV_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Scalar.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/Preconditioner.hh"
+
+/* metody iteracyjne potrzebuja od operatora A tylko apply(x) = Ax i size(), a od uwarunkowania wstepnego
+ * tylko apply(r) ~ M^-1 r; poza operatorem pamietaja kilka wektorow dlugosci n (GMRES restart + 1) */
+
+/**
+ * Operator liniowy mnozacy przez macierz (dowolna, dla ktorej matrix * DynamicVector jest wyrazeniem wektorowym)
+ * @tparam M
+ */
+template <class M>
+class MatrixOperator {
+public:
+    using scalar_type = typename M::scalar_type; /** Typ skalara */
+
+    /**
+     * Zapamietuje referencje na macierz
+     * @param matrix
+     */
+    explicit MatrixOperator(const M& matrix) : matrix(matrix) {}
+
+    /**
+     * Zwraca rozmiar operatora
+     * @return rozmiar
+     */
+    size_t size() const {
+        return matrix.rows();
+    }
+
+    /**
+     * Wylicza Ax
+     * @param vector
+     * @return wektor
+     */
+    DynamicVector<scalar_type> apply(const DynamicVector<scalar_type>& vector) const {
+        return matrix * vector;
+    }
+
+private:
+    const M& matrix; /** Macierz */
+};
+
+/**
+ * Operator liniowy zadany funkcja uzytkownika, bez macierzy w pamieci
+ * @tparam T
+ */
+template <class T>
+class FunctionOperator {
+public:
+    using scalar_type = T; /** Typ skalara */
+    using function_type = std::function<DynamicVector<T>(const DynamicVector<T>&)>; /** Typ funkcji x -> Ax */
+
+    /**
+     * Zapamietuje funkcje
+     * @param size
+     * @param function
+     */
+    FunctionOperator(const size_t size, function_type function) : length(size), function(std::move(function)) {}
+
+    /**
+     * @see MatrixOperator::size
+     */
+    size_t size() const {
+        return length;
+    }
+
+    /**
+     * @see MatrixOperator::apply
+     */
+    DynamicVector<T> apply(const DynamicVector<T>& vector) const {
+        return function(vector);
+    }
+
+private:
+    size_t length; /** Rozmiar operatora */
+    function_type function; /** Funkcja x -> Ax */
+};
+
+/**
+ * Warunki zatrzymania metod iteracyjnych: koniec, gdy ||b - Ax|| <= max(relative * ||b||, absolute)
+ * lub po max_iterations iteracjach
+ * @tparam R typ czesci rzeczywistej skalara
+ */
+template <class R>
+struct IterativeCriteria {
+    size_t max_iterations = 1000; /** Najwieksza liczba iteracji (mnozen przez A) */
+    R relative = std::sqrt(std::numeric_limits<R>::epsilon()); /** Tolerancja wzgledem ||b|| */
+    R absolute = 0; /** Tolerancja bezwzgledna */
+    size_t restart = 30; /** Liczba wektorow bazy GMRES przed restartem */
+};
+
+/**
+ * Przebieg metody iteracyjnej
+ * @tparam R typ czesci rzeczywistej skalara
+ */
+template <class R>
+struct IterativeReport {
+    size_t iterations = 0; /** Liczba wykonanych iteracji */
+    R residual = 0; /** Norma euklidesowa b - Ax dla zwroconego x */
+    bool converged = false; /** Czy osiagnieto tolerancje */
+};
+
+/**
+ * Metody Krylowa dla ukladu Ax = b o skalarach T; x na wejsciu jest przyblizeniem poczatkowym
+ * (pusty wektor - zera), na wyjsciu rozwiazaniem
+ * @tparam T
+ */
+template <class T>
+struct Krylov {
+    using R = typename Scalar<T>::real_type;
+
+    /**
+     * Gradienty sprzezone, dla A (i M) hermitowskich dodatnio okreslonych
+     * @param matrix operator A
+     * @param vector wektor b
+     * @param unknown wektor x
+     * @param criteria
+     * @param preconditioner
+     * @return przebieg
+     */
+    template <class A, class P = IdentityPreconditioner<T>>
+    static IterativeReport<R> cg(const A& matrix, const DynamicVector<T>& vector, DynamicVector<T>& unknown,
+                                 const IterativeCriteria<R>& criteria = {}, const P& preconditioner = P());
+
+    /**
+     * BiCGSTAB z uwarunkowaniem prawostronnym, dla dowolnej nieosobliwej A
+     * @see cg
+     */
+    template <class A, class P = IdentityPreconditioner<T>>
+    static IterativeReport<R> bicgstab(const A& matrix, const DynamicVector<T>& vector, DynamicVector<T>& unknown,
+                                       const IterativeCriteria<R>& criteria = {}, const P& preconditioner = P());
+
+    /**
+     * GMRES z restartem co criteria.restart iteracji i uwarunkowaniem prawostronnym, dla dowolnej nieosobliwej A
+     * @see cg
+     */
+    template <class A, class P = IdentityPreconditioner<T>>
+    static IterativeReport<R> gmres(const A& matrix, const DynamicVector<T>& vector, DynamicVector<T>& unknown,
+                                    const IterativeCriteria<R>& criteria = {}, const P& preconditioner = P());
+
+    /**
+     * Wylicza iloczyn skalarny sum conj(a[i]) b[i]
+     * @param a
+     * @param b
+     * @return wartosc
+     */
+    static T inner(const DynamicVector<T>& a, const DynamicVector<T>& b);
+
+    /**
+     * Wylicza norme euklidesowa
+     * @param vector
+     * @return wartosc
+     */
+    static R norm(const DynamicVector<T>& vector);
+
+private:
+    /**
+     * Przygotowuje x i wylicza b - Ax
+     * @param matrix
+     * @param vector
+     * @param unknown
+     * @return wektor reszt
+     */
+    template <class A>
+    static DynamicVector<T> start(const A& matrix, const DynamicVector<T>& vector, DynamicVector<T>& unknown);
+
+    /**
+     * Wylicza prog zatrzymania
+     * @param criteria
+     * @param vector
+     * @return prog dla ||b - Ax||
+     */
+    static R threshold(const IterativeCriteria<R>& criteria, const DynamicVector<T>& vector);
+};
+
+template <class T>
+T Krylov<T>::inner(const DynamicVector<T>& a, const DynamicVector<T>& b) {
+    if constexpr (!Scalar<T>::complex) {
+        return a.dot(b);
+    } else {
+        T result = T();
+        for (size_t i = 0; i < a.length(); i++)
+            result += Scalar<T>::conjugate(a[i]) * b[i];
+        return result;
+    }
+}
+
+template <class T>
+typename Krylov<T>::R Krylov<T>::norm(const DynamicVector<T>& vector) {
+    return std::sqrt(Scalar<T>::real(inner(vector, vector)));
+}
+
+template <class T>
+template <class A>
+DynamicVector<T> Krylov<T>::start(const A& matrix, const DynamicVector<T>& vector, DynamicVector<T>& unknown) {
+    if (matrix.size() != vector.length())
+        throw std::runtime_error("Size mismatch");
+    if (unknown.length() == 0)
+        unknown = DynamicVector<T>(vector.length());
+    if (unknown.length() != vector.length())
+        throw std::runtime_error("Size mismatch");
+
+    return vector - matrix.apply(unknown);
+}
+
+template <class T>
+typename Krylov<T>::R Krylov<T>::threshold(const IterativeCriteria<R>& criteria, const DynamicVector<T>& vector) {
+    return std::max(criteria.relative * norm(vector), criteria.absolute);
+}
+
+template <class T>
+template <class A, class P>
+IterativeReport<typename Krylov<T>::R> Krylov<T>::cg(const A& matrix, const DynamicVector<T>& vector, DynamicVector<T>& unknown,
+                                                     const IterativeCriteria<R>& criteria, const P& preconditioner) {
+    IterativeReport<R> report;
+    const R limit = threshold(criteria, vector);
+
+    DynamicVector<T> residual = start(matrix, vector, unknown);
+
+    /* reszta aktualizowana rekurencyjnie odplywa od b - Ax, wiec po zejsciu ponizej progu jest wyliczana
+     * od nowa, a jesli ta jest wciaz za duza, metoda startuje ponownie od osiagnietego x */
+    while ((report.residual = norm(residual)) > limit && report.iterations < criteria.max_iterations) {
+        DynamicVector<T> direction = preconditioner.apply(residual);
+        T rho = inner(residual, direction);
+
+        while (norm(residual) > limit && report.iterations < criteria.max_iterations) {
+            const DynamicVector<T> product = matrix.apply(direction);
+            const T alpha = rho / inner(direction, product);
+
+            unknown = unknown + direction * alpha;
+            residual = residual - product * alpha;
+            report.iterations++;
+
+            const DynamicVector<T> preconditioned = preconditioner.apply(residual);
+            const T next = inner(residual, preconditioned);
+            direction = preconditioned + direction * (next / rho);
+            rho = next;
+        }
+
+        residual = vector - matrix.apply(unknown);
+    }
+
+    report.converged = report.residual <= limit;
+    return report;
+}
+
+template <class T>
+template <class A, class P>
+IterativeReport<typename Krylov<T>::R> Krylov<T>::bicgstab(const A& matrix, const DynamicVector<T>& vector,
+                                                           DynamicVector<T>& unknown, const IterativeCriteria<R>& criteria,
+                                                           const P& preconditioner) {
+    IterativeReport<R> report;
+    const R limit = threshold(criteria, vector);
+
+    DynamicVector<T> residual = start(matrix, vector, unknown);
+
+    /* ponowne starty jak w cg */
+    while ((report.residual = norm(residual)) > limit && report.iterations < criteria.max_iterations) {
+        const DynamicVector<T> shadow = residual;
+        DynamicVector<T> direction(vector.length());
+        DynamicVector<T> product(vector.length());
+        T rho = T(1), alpha = T(1), omega = T(1);
+        const size_t first = report.iterations;
+
+        while (norm(residual) > limit && report.iterations < criteria.max_iterations) {
+            const T next = inner(shadow, residual);
+            /* rozpad metody: reszta prostopadla do wektora cienia */
+            if (Scalar<T>::magnitude(next) == 0 || Scalar<T>::magnitude(omega) == 0)
+                break;
+
+            direction = residual + (direction - product * omega) * ((next / rho) * (alpha / omega));
+            const DynamicVector<T> preconditioned = preconditioner.apply(direction);
+            product = matrix.apply(preconditioned);
+            alpha = next / inner(shadow, product);
+            rho = next;
+
+            const DynamicVector<T> half = residual - product * alpha;
+            report.iterations++;
+            if (norm(half) <= limit) {
+                unknown = unknown + preconditioned * alpha;
+                residual = half;
+                continue;
+            }
+
+            const DynamicVector<T> half_preconditioned = preconditioner.apply(half);
+            const DynamicVector<T> half_product = matrix.apply(half_preconditioned);
+            omega = inner(half_product, half) / inner(half_product, half_product);
+
+            unknown = unknown + preconditioned * alpha + half_preconditioned * omega;
+            residual = half - half_product * omega;
+        }
+
+        residual = vector - matrix.apply(unknown);
+        if (report.iterations == first) {
+            report.residual = norm(residual);
+            break;
+        }
+    }
+
+    report.converged = report.residual <= limit;
+    return report;
+}
+
+template <class T>
+template <class A, class P>
+IterativeReport<typename Krylov<T>::R> Krylov<T>::gmres(const A& matrix, const DynamicVector<T>& vector, DynamicVector<T>& unknown,
+                                                        const IterativeCriteria<R>& criteria, const P& preconditioner) {
+    IterativeReport<R> report;
+    const R limit = threshold(criteria, vector);
+    const size_t restart = std::max<size_t>(criteria.restart, 1);
+
+    std::vector<DynamicVector<T>> basis(restart + 1);
+    std::vector<T> hessenberg((restart + 1) * restart); /* kolumna j: hessenberg[j * (restart + 1) + i] */
+    std::vector<R> cosines(restart);
+    std::vector<T> sines(restart);
+    std::vector<T> rotated(restart + 1); /* ||r|| e1 po obrotach Givensa */
+
+    DynamicVector<T> residual = start(matrix, vector, unknown);
+
+    while ((report.residual = norm(residual)) > limit && report.iterations < criteria.max_iterations) {
+        basis[0] = residual / T(report.residual);
+        std::fill(rotated.begin(), rotated.end(), T());
+        rotated[0] = T(report.residual);
+
+        size_t k = 0;
+        while (k < restart && report.iterations < criteria.max_iterations) {
+            T* column = hessenberg.data() + k * (restart + 1);
+            DynamicVector<T> next = matrix.apply(preconditioner.apply(basis[k]));
+
+            /* zmodyfikowany Gram-Schmidt */
+            for (size_t i = 0; i <= k; i++) {
+                column[i] = inner(basis[i], next);
+                next = next - basis[i] * column[i];
+            }
+            const R length = norm(next);
+            column[k + 1] = T(length);
+
+            for (size_t i = 0; i < k; i++) {
+                const T upper = column[i];
+                column[i] = upper * T(cosines[i]) + sines[i] * column[i + 1];
+                column[i + 1] = column[i + 1] * T(cosines[i]) - Scalar<T>::conjugate(sines[i]) * upper;
+            }
+
+            /* obrot zerujacy column[k + 1] */
+            const R diagonal = Scalar<T>::absolute(column[k]);
+            const R hypotenuse = std::hypot(diagonal, length);
+            if (diagonal == 0) {
+                cosines[k] = 0;
+                sines[k] = T(1);
+            } else {
+                const T phase = column[k] / T(diagonal);
+                cosines[k] = diagonal / hypotenuse;
+                sines[k] = phase * T(length / hypotenuse);
+            }
+            column[k] = T(cosines[k]) * column[k] + sines[k] * column[k + 1];
+            column[k + 1] = T();
+            rotated[k + 1] = T(0) - Scalar<T>::conjugate(sines[k]) * rotated[k];
+            rotated[k] = T(cosines[k]) * rotated[k];
+
+            report.iterations++;
+            k++;
+            if (length == 0 || Scalar<T>::absolute(rotated[k]) <= limit)
+                break;
+            basis[k] = next / T(length);
+        }
+
+        /* y = H^-1 g, x += M^-1 V y */
+        std::vector<T> weights(k);
+        for (size_t i = k; i-- > 0;) {
+            T sum = rotated[i];
+            for (size_t j = i + 1; j < k; j++)
+                sum -= hessenberg[j * (restart + 1) + i] * weights[j];
+            weights[i] = sum / hessenberg[i * (restart + 1) + i];
+        }
+
+        DynamicVector<T> correction(vector.length());
+        for (size_t i = 0; i < k; i++)
+            correction = correction + basis[i] * weights[i];
+        unknown = unknown + preconditioner.apply(correction);
+        residual = vector - matrix.apply(unknown);
+    }
+
+    report.converged = report.residual <= limit;
+    return report;
+}
+
+#endif //ZAD3_KRYLOV_HH
@@ -0,0 +1,245 @@
+#ifndef ZAD3_LUDECOMPOSITION_HH
+#define ZAD3_LUDECOMPOSITION_HH
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../inc/Complex.hh"
+#include "../inc/Factorization.hh"
+#include "../inc/BlockedFactorization.hh"
+#include "../inc/Vector.hh"
+#include "../inc/Matrix.hh"
+#include "../inc/AlignedAllocator.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/Instrumentation.hh"
+
+/**
+ * Klasa reprezentujaca rozklad LU macierzy o skalarach T i rozmiarze size (PA = LU)
+ * @tparam T
+ * @tparam size
+ */
+template <class T, size_t size>
+class LUDecomposition {
+public:
+    /**
+     * Rozklada podana macierz
+     * @param matrix
+     */
+    explicit LUDecomposition(const Matrix<T, size>& matrix);
+
+    /**
+     * Rozklada macierz widoczna przez widok, przepisujac ja tylko raz do czynnikow rozkladu
+     * @param view
+     */
+    template <class D>
+    explicit LUDecomposition(const MatrixView<D>& view);
+
+    /**
+     * Wylicza wyznacznik rozlozonej macierzy
+     * @return wartosc
+     */
+    T det() const;
+
+    /**
+     * Rozwiazuje uklad Ax = b dla rozlozonej macierzy A
+     * @param vector wektor b
+     * @return wektor x
+     */
+    Vector<T, size> solve(const Vector<T, size>& vector) const;
+
+    /**
+     * Rozwiazuje uklady AX = B dla wielu prawych stron naraz, kazda kolejna kosztuje O(n^2)
+     * @param block macierz B o size wierszach, kolumny to kolejne wektory b
+     * @return macierz X, kolumny to kolejne rozwiazania
+     */
+    DynamicMatrix<T> solve(const DynamicMatrix<T>& block) const;
+
+private:
+    Matrix<T, size> factors; /** Macierze L i U zapisane razem */
+    size_t permutation[size]; /** Permutacja wierszy */
+    bool odd; /** Nieparzystosc permutacji */
+};
+
+template <class T, size_t size>
+LUDecomposition<T, size>::LUDecomposition(const Matrix<T, size>& matrix) : factors(matrix) {
+    ZAD3_PHASE(Phase::factorization, Cost<T>::factorization(size), size * size * sizeof(T));
+    odd = Factorization<T>::decompose(factors, size, permutation);
+    ZAD3_PIVOTS(factors, size, permutation);
+}
+
+template <class T, size_t size>
+template <class D>
+LUDecomposition<T, size>::LUDecomposition(const MatrixView<D>& view) : factors(view) {
+    ZAD3_PHASE(Phase::factorization, Cost<T>::factorization(size), size * size * sizeof(T));
+    odd = Factorization<T>::decompose(factors, size, permutation);
+    ZAD3_PIVOTS(factors, size, permutation);
+}
+
+template <class T, size_t size>
+T LUDecomposition<T, size>::det() const {
+    return Factorization<T>::det(factors, size, odd);
+}
+
+template <class T, size_t size>
+Vector<T, size> LUDecomposition<T, size>::solve(const Vector<T, size>& vector) const {
+    ZAD3_PHASE(Phase::substitution, Cost<T>::product(size), size * size * sizeof(T));
+    Vector<T, size> result;
+    for (size_t i = 0; i < size; i++)
+        result[i] = vector[permutation[i]];
+
+    Factorization<T>::substitute(factors, size, result);
+    return result;
+}
+
+template <class T, size_t size>
+DynamicMatrix<T> LUDecomposition<T, size>::solve(const DynamicMatrix<T>& block) const {
+    if (block.rows() != size)
+        throw std::runtime_error("Size mismatch");
+
+    ZAD3_PHASE(Phase::substitution, Cost<T>::product(size) * block.columns(), size * size * sizeof(T));
+    DynamicMatrix<T> result(size, block.columns());
+    for (size_t i = 0; i < size; i++)
+        std::copy(block[permutation[i]], block[permutation[i]] + block.columns(), result[i]);
+
+    Factorization<T>::substitute_block(factors, size, result);
+    return result;
+}
+
+/**
+ * Klasa reprezentujaca rozklad LU macierzy kwadratowej o skalarach T i rozmiarze ustalanym w czasie wykonania
+ * @tparam T
+ */
+template <class T>
+class DynamicLUDecomposition {
+public:
+    /**
+     * Rozklada podana macierz
+     * @param matrix
+     */
+    explicit DynamicLUDecomposition(const DynamicMatrix<T>& matrix);
+
+    /**
+     * Rozklada podana macierz na watkach puli (duze macierze, mniejsze rozkladane sa na watku wywolujacym)
+     * @param matrix
+     * @param pool
+     */
+    DynamicLUDecomposition(const DynamicMatrix<T>& matrix, ThreadPool& pool);
+
+    /**
+     * Rozklada macierz widoczna przez widok, przepisujac ja tylko raz do czynnikow rozkladu
+     * @param view
+     */
+    template <class D>
+    explicit DynamicLUDecomposition(const MatrixView<D>& view);
+
+    /**
+     * Zwraca rozmiar rozlozonej macierzy
+     * @return rozmiar
+     */
+    size_t size() const;
+
+    /**
+     * Wylicza wyznacznik rozlozonej macierzy
+     * @return wartosc
+     */
+    T det() const;
+
+    /**
+     * Rozwiazuje uklad Ax = b dla rozlozonej macierzy A
+     * @param vector wektor b
+     * @return wektor x
+     */
+    DynamicVector<T> solve(const DynamicVector<T>& vector) const;
+
+    /**
+     * @see LUDecomposition::solve(const DynamicMatrix<T>&)
+     */
+    DynamicMatrix<T> solve(const DynamicMatrix<T>& block) const;
+
+private:
+    DynamicMatrix<T> factors; /** Macierze L i U zapisane razem */
+    std::vector<size_t, AlignedAllocator<size_t>> permutation; /** Permutacja wierszy */
+    bool odd; /** Nieparzystosc permutacji */
+};
+
+template <class T>
+DynamicLUDecomposition<T>::DynamicLUDecomposition(const DynamicMatrix<T>& matrix)
+        : factors(matrix), permutation(matrix.rows()) {
+    if (matrix.rows() != matrix.columns())
+        throw std::runtime_error("Matrix is not square");
+
+    ZAD3_PHASE(Phase::factorization, Cost<T>::factorization(size()), size() * size() * sizeof(T));
+    odd = size() >= BlockedFactorization<T>::threshold
+          ? BlockedFactorization<T>::decompose(factors, permutation.data())
+          : Factorization<T>::decompose(factors, size(), permutation.data());
+    ZAD3_PIVOTS(factors, size(), permutation.data());
+}
+
+template <class T>
+DynamicLUDecomposition<T>::DynamicLUDecomposition(const DynamicMatrix<T>& matrix, ThreadPool& pool)
+        : factors(matrix), permutation(matrix.rows()) {
+    if (matrix.rows() != matrix.columns())
+        throw std::runtime_error("Matrix is not square");
+
+    ZAD3_PHASE(Phase::factorization, Cost<T>::factorization(size()), size() * size() * sizeof(T));
+    odd = size() >= BlockedFactorization<T>::threshold
+          ? BlockedFactorization<T>::decompose(factors, permutation.data(), pool)
+          : Factorization<T>::decompose(factors, size(), permutation.data());
+    ZAD3_PIVOTS(factors, size(), permutation.data());
+}
+
+template <class T>
+template <class D>
+DynamicLUDecomposition<T>::DynamicLUDecomposition(const MatrixView<D>& view)
+        : factors(view), permutation(factors.rows()) {
+    if (factors.rows() != factors.columns())
+        throw std::runtime_error("Matrix is not square");
+
+    ZAD3_PHASE(Phase::factorization, Cost<T>::factorization(size()), size() * size() * sizeof(T));
+    odd = size() >= BlockedFactorization<T>::threshold
+          ? BlockedFactorization<T>::decompose(factors, permutation.data())
+          : Factorization<T>::decompose(factors, size(), permutation.data());
+    ZAD3_PIVOTS(factors, size(), permutation.data());
+}
+
+template <class T>
+size_t DynamicLUDecomposition<T>::size() const {
+    return permutation.size();
+}
+
+template <class T>
+T DynamicLUDecomposition<T>::det() const {
+    return Factorization<T>::det(factors, size(), odd);
+}
+
+template <class T>
+DynamicVector<T> DynamicLUDecomposition<T>::solve(const DynamicVector<T>& vector) const {
+    if (vector.length() != size())
+        throw std::runtime_error("Size mismatch");
+
+    ZAD3_PHASE(Phase::substitution, Cost<T>::product(size()), size() * size() * sizeof(T));
+    DynamicVector<T> result(size());
+    for (size_t i = 0; i < size(); i++)
+        result[i] = vector[permutation[i]];
+
+    Factorization<T>::substitute(factors, size(), result);
+    return result;
+}
+
+template <class T>
+DynamicMatrix<T> DynamicLUDecomposition<T>::solve(const DynamicMatrix<T>& block) const {
+    if (block.rows() != size())
+        throw std::runtime_error("Size mismatch");
+
+    ZAD3_PHASE(Phase::substitution, Cost<T>::product(size()) * block.columns(), size() * size() * sizeof(T));
+    DynamicMatrix<T> result(size(), block.columns());
+    for (size_t i = 0; i < size(); i++)
+        std::copy(block[permutation[i]], block[permutation[i]] + block.columns(), result[i]);
+
+    Factorization<T>::substitute_block(factors, size(), result);
+    return result;
+}
+
+#endif //ZAD3_LUDECOMPOSITION_HH
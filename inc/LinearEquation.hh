@@ -2,10 +2,23 @@
 #define ZAD3_LINEAREQUATION_HH
 
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 
 #include "../inc/Complex.hh"
 #include "../inc/Vector.hh"
 #include "../inc/Matrix.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/LUDecomposition.hh"
+#include "../inc/SplitComplex.hh"
+#include "../inc/Refinement.hh"
+#include "../inc/SparseMatrix.hh"
+#include "../inc/Krylov.hh"
+#include "../inc/UpdatedLUDecomposition.hh"
+#include "../inc/FixedSolver.hh"
+#include "../inc/Instrumentation.hh"
 
 /**
  * Klasa reprezentujaca rownanie liniowe o skalarach T i rozmiarze size
@@ -22,22 +35,309 @@ public:
     Vector<T, size> result_vector; /** Wektor rozwiazan */
 
     /**
-     * Rozwiazuje rownanie liniowe ustawiajac odpowiednie atrybuty klasy
+     * Rozwiazuje rownanie liniowe ustawiajac odpowiednie atrybuty klasy: do rozmiaru fixed_solver_limit
+     * rozwinieta eliminacja Gaussa (FixedSolver.hh), dla wiekszych rozkladem LU
      */
     void solve();
+
+    /**
+     * Rozwiazuje rownanie o skalarach zespolonych jak solve(), ale na kopii z rozdzielonymi
+     * czesciami rzeczywistymi i urojonymi (SplitComplex.hh), liczonej wektoryzowanymi jadrami
+     */
+    void solve_split();
 };
 
 template <class T, size_t size>
 void LinearEquation<T, size>::solve() {
-    const T determinant = factor_matrix.det();
+    if constexpr (size <= fixed_solver_limit) {
+        FixedSolver<T, size>::solve(factor_matrix, result_vector, unknown_vector);
+    } else {
+        const LUDecomposition<T, size> decomposition(factor_matrix);
+        unknown_vector = decomposition.solve(result_vector);
+    }
+
+    ZAD3_PHASE(Phase::residual, Cost<T>::product(size), size * size * sizeof(T));
+    error_vector = factor_matrix * unknown_vector - result_vector;
+}
+
+template <class T, size_t size>
+void LinearEquation<T, size>::solve_split() {
+    static_assert(Scalar<T>::complex, "Split layout requires complex scalars");
+    using R = typename Scalar<T>::real_type;
+
+    const SplitComplexMatrix<R> matrix(factor_matrix);
+    const SplitComplexVector<R> result(result_vector);
+    const SplitComplexVector<R> unknown = SplitComplexLUDecomposition<R>(matrix).solve(result);
+
+    unknown_vector = unknown;
+    ZAD3_PHASE(Phase::residual, Cost<T>::product(size), size * size * sizeof(T));
+    error_vector = matrix * unknown - result;
+}
+
+/**
+ * Klasa reprezentujaca rownanie liniowe o skalarach T i rozmiarze ustalanym w czasie wykonania
+ * @tparam T
+ */
+template <class T>
+class DynamicLinearEquation {
+public:
+    DynamicVector<T> unknown_vector; /** Wektor niewiadomych */
+    DynamicVector<T> error_vector; /** Wektor bledu */
+
+    DynamicMatrix<T> factor_matrix; /** Macierz wspolczynnikow */
+    DynamicVector<T> result_vector; /** Wektor rozwiazan */
+
+    /**
+     * Zwraca liczbe niewiadomych wyznaczona przez macierz wspolczynnikow
+     * @return rozmiar
+     */
+    size_t size() const;
+
+    /**
+     * @see LinearEquation::solve
+     */
+    void solve();
+
+    /**
+     * Rozwiazuje rownanie jak solve(), rozkladajac macierz na watkach puli
+     * @param pool
+     */
+    void solve(ThreadPool& pool);
+
+    /**
+     * Rozwiazuje rownanie rozkladajac macierz w pojedynczej precyzji (float lub Complex<float>), a potem
+     * poprawia rozwiazanie x -= A^-1 (Ax-b) z wektorem bledu liczonym w precyzji T, az ||Ax-b|| spadnie do
+     * tolerance * ||A|| * ||x||; gdy poprawki przestaja zmniejszac blad, rozwiazuje uklad jak solve()
+     * @param tolerance blad wzgledny (0 - osiagalny w precyzji T)
+     * @param max_iterations najwieksza liczba poprawek
+     * @return liczba poprawek i norma koncowego wektora bledu
+     */
+    RefinementReport<typename Scalar<T>::real_type> solve_refined(typename Scalar<T>::real_type tolerance = 0,
+                                                                   size_t max_iterations = Refinement<T>::max_iterations);
+
+    /**
+     * @see LinearEquation::solve_split
+     */
+    void solve_split();
+};
+
+template <class T>
+size_t DynamicLinearEquation<T>::size() const {
+    return factor_matrix.rows();
+}
+
+template <class T>
+void DynamicLinearEquation<T>::solve() {
+    solve_fixed(factor_matrix, result_vector, unknown_vector);
+    ZAD3_PHASE(Phase::residual, Cost<T>::product(size()), size() * size() * sizeof(T));
+    residual_fixed(factor_matrix, result_vector, unknown_vector, error_vector);
+}
+
+template <class T>
+void DynamicLinearEquation<T>::solve(ThreadPool& pool) {
+    const DynamicLUDecomposition<T> decomposition(factor_matrix, pool);
+    unknown_vector = decomposition.solve(result_vector);
+    ZAD3_PHASE(Phase::residual, Cost<T>::product(size()), size() * size() * sizeof(T));
+    error_vector = factor_matrix * unknown_vector - result_vector;
+}
+
+template <class T>
+RefinementReport<typename Scalar<T>::real_type> DynamicLinearEquation<T>::solve_refined(typename Scalar<T>::real_type tolerance,
+                                                                                        const size_t max_iterations) {
+    using R = typename Scalar<T>::real_type;
+    using S = typename Scalar<T>::single_type;
+
+    if (tolerance == 0)
+        tolerance = Refinement<T>::tolerance(size());
+
+    RefinementReport<R> report;
+    try {
+        const DynamicLUDecomposition<S> decomposition(Refinement<T>::lower(factor_matrix));
+        const R matrix_norm = Refinement<T>::norm(factor_matrix);
+
+        unknown_vector = Refinement<T>::raise(decomposition.solve(Refinement<T>::lower(result_vector)));
+        R previous = std::numeric_limits<R>::infinity();
+
+        while (true) {
+            {
+                ZAD3_PHASE(Phase::residual, Cost<T>::product(size()), size() * size() * sizeof(T));
+                error_vector = factor_matrix * unknown_vector - result_vector;
+            }
+            report.residual = Refinement<T>::norm(error_vector);
+
+            if (report.residual <= tolerance * matrix_norm * Refinement<T>::norm(unknown_vector)) {
+                report.converged = true;
+                return report;
+            }
+            /* blad nie maleje (lub jest NaN): macierz zbyt zle uwarunkowana na pojedyncza precyzje */
+            if (report.iterations == max_iterations || !(report.residual < previous))
+                break;
+
+            previous = report.residual;
+            unknown_vector = unknown_vector - Refinement<T>::raise(decomposition.solve(Refinement<T>::lower(error_vector)));
+            report.iterations++;
+        }
+    } catch (const std::runtime_error&) {
+        /* macierz osobliwa dopiero po zaokragleniu do pojedynczej precyzji (np. element 1e-50 staje sie zerem):
+         * uklad rozwiazywany jest od razu w pelnej precyzji */
+        report.iterations = 0;
+    }
+
+    solve();
+    report.residual = Refinement<T>::norm(error_vector);
+    return report;
+}
+
+template <class T>
+void DynamicLinearEquation<T>::solve_split() {
+    static_assert(Scalar<T>::complex, "Split layout requires complex scalars");
+    using R = typename Scalar<T>::real_type;
 
-    for (size_t i = 0; i < size; i++)
-        unknown_vector[i] = factor_matrix.replace_column(result_vector, i).det() / determinant;
+    const SplitComplexMatrix<R> matrix(factor_matrix);
+    const SplitComplexVector<R> result(result_vector);
+    const SplitComplexVector<R> unknown = SplitComplexLUDecomposition<R>(matrix).solve(result);
+
+    unknown_vector = unknown;
+    ZAD3_PHASE(Phase::residual, Cost<T>::product(size()), size() * size() * sizeof(T));
+    error_vector = matrix * unknown - result;
+}
+
+/**
+ * Klasa reprezentujaca rownanie liniowe, ktorego macierz wspolczynnikow zmieniana jest kolumnami,
+ * wierszami lub poprawkami niskiego rzedu i rozwiazywana ponownie bez pelnego rozkladu
+ * (UpdatedLUDecomposition.hh); macierz zmieniana jest wylacznie metodami atrybutu decomposition
+ * @tparam T
+ */
+template <class T>
+class IncrementalLinearEquation {
+public:
+    DynamicVector<T> unknown_vector; /** Wektor niewiadomych */
+    DynamicVector<T> error_vector; /** Wektor bledu */
+
+    UpdatedLUDecomposition<T> decomposition; /** Macierz wspolczynnikow wraz z rozkladem */
+    DynamicVector<T> result_vector; /** Wektor rozwiazan */
+
+    /**
+     * Rozklada macierz wspolczynnikow rownania
+     * @param equation
+     * @param refactor_interval liczba poprawek, po ktorej macierz jest rozkladana od nowa
+     */
+    explicit IncrementalLinearEquation(const DynamicLinearEquation<T>& equation,
+                                       size_t refactor_interval = UpdatedLUDecomposition<T>::default_refactor_interval);
 
+    /**
+     * @see DynamicLinearEquation::size
+     */
+    size_t size() const;
+
+    /**
+     * Rozwiazuje rownanie z macierza po wszystkich poprawkach w O(n^2 + kn) ustawiajac wektor
+     * niewiadomych i bledu
+     */
+    void solve();
+};
+
+template <class T>
+IncrementalLinearEquation<T>::IncrementalLinearEquation(const DynamicLinearEquation<T>& equation, const size_t refactor_interval)
+        : decomposition(equation.factor_matrix, refactor_interval), result_vector(equation.result_vector) {}
+
+template <class T>
+size_t IncrementalLinearEquation<T>::size() const {
+    return decomposition.size();
+}
+
+template <class T>
+void IncrementalLinearEquation<T>::solve() {
+    unknown_vector = decomposition.solve(result_vector);
+    ZAD3_PHASE(Phase::residual, Cost<T>::product(size()), size() * size() * sizeof(T));
+    error_vector = decomposition.matrix() * unknown_vector - result_vector;
+}
+
+/**
+ * Klasa reprezentujaca rownanie liniowe o rzadkiej macierzy wspolczynnikow, rozwiazywane iteracyjnie
+ * bez tworzenia gestej macierzy
+ * @tparam T
+ */
+template <class T>
+class SparseLinearEquation {
+public:
+    DynamicVector<T> unknown_vector; /** Wektor niewiadomych */
+    DynamicVector<T> error_vector; /** Wektor bledu */
+
+    SparseMatrix<T> factor_matrix; /** Macierz wspolczynnikow */
+    DynamicVector<T> result_vector; /** Wektor rozwiazan */
+
+    /**
+     * @see DynamicLinearEquation::size
+     */
+    size_t size() const;
+
+    /**
+     * Rozwiazuje rownanie metoda BiCGSTAB z uwarunkowaniem ILU(0), a gdy ta nie osiagnie tolerancji,
+     * kontynuuje od osiagnietego przyblizenia metoda GMRES; gdy rozklad ILU(0) jest niemozliwy (zero
+     * na przekatnej, np. przy macierzy permutacji), obie metody dzialaja bez uwarunkowania; ustawia wektor
+     * niewiadomych i bledu
+     * @param criteria warunki zatrzymania kazdej z metod
+     * @return przebieg (iteracje obu metod razem)
+     */
+    IterativeReport<typename Scalar<T>::real_type> solve(const IterativeCriteria<typename Scalar<T>::real_type>& criteria = {});
+
+private:
+    /**
+     * Wyznacza wektor niewiadomych metoda BiCGSTAB, a w razie braku zbieznosci metoda GMRES
+     * @tparam P typ uwarunkowania wstepnego
+     * @param criteria
+     * @param preconditioner
+     * @return przebieg (iteracje obu metod razem)
+     */
+    template <class P>
+    IterativeReport<typename Scalar<T>::real_type> iterate(const IterativeCriteria<typename Scalar<T>::real_type>& criteria,
+                                                           const P& preconditioner);
+};
+
+template <class T>
+size_t SparseLinearEquation<T>::size() const {
+    return factor_matrix.rows();
+}
+
+template <class T>
+IterativeReport<typename Scalar<T>::real_type> SparseLinearEquation<T>::solve(
+        const IterativeCriteria<typename Scalar<T>::real_type>& criteria) {
+    std::unique_ptr<const ILUPreconditioner<T>> preconditioner;
+    try {
+        preconditioner.reset(new ILUPreconditioner<T>(factor_matrix));
+    } catch (const std::runtime_error&) {}
+
+    const auto report = preconditioner ? iterate(criteria, *preconditioner) : iterate(criteria, IdentityPreconditioner<T>());
+
+    ZAD3_PHASE(Phase::residual, Cost<T>::scale * 2 * factor_matrix.nonzeros(), factor_matrix.nonzeros() * sizeof(T));
     error_vector = factor_matrix * unknown_vector - result_vector;
+    return report;
+}
+
+template <class T>
+template <class P>
+IterativeReport<typename Scalar<T>::real_type> SparseLinearEquation<T>::iterate(
+        const IterativeCriteria<typename Scalar<T>::real_type>& criteria, const P& preconditioner) {
+    const MatrixOperator<SparseMatrix<T>> matrix(factor_matrix);
+
+    unknown_vector = DynamicVector<T>();
+    auto report = Krylov<T>::bicgstab(matrix, result_vector, unknown_vector, criteria, preconditioner);
+    if (!report.converged) {
+        const size_t iterations = report.iterations;
+        report = Krylov<T>::gmres(matrix, result_vector, unknown_vector, criteria, preconditioner);
+        report.iterations += iterations;
+    }
+    return report;
 }
 
 using LinearEquation5d = LinearEquation<double, 5>; /** Alias dla rownania 5x5 liczb rzeczywistych */
-using LinearEquation5c = LinearEquation<Complex<double>, 5>; /** Alias dla rownania 5x5 liczb zespolonych
+using LinearEquation5c = LinearEquation<Complex<double>, 5>; /** Alias dla rownania 5x5 liczb zespolonych */
+using DynamicLinearEquationd = DynamicLinearEquation<double>; /** Alias dla rownania liczb rzeczywistych */
+using DynamicLinearEquationc = DynamicLinearEquation<Complex<double>>; /** Alias dla rownania liczb zespolonych */
+using IncrementalLinearEquationd = IncrementalLinearEquation<double>; /** Alias dla zmienianego rownania liczb rzeczywistych */
+using IncrementalLinearEquationc = IncrementalLinearEquation<Complex<double>>; /** Alias dla zmienianego rownania liczb zespolonych */
+using SparseLinearEquationd = SparseLinearEquation<double>; /** Alias dla rzadkiego rownania liczb rzeczywistych */
+using SparseLinearEquationc = SparseLinearEquation<Complex<double>>; /** Alias dla rzadkiego rownania liczb zespolonych */
 
 #endif //ZAD3_LINEAREQUATION_HH
@@ -0,0 +1,58 @@
+#ifndef ZAD3_MAPPEDFILE_HH
+#define ZAD3_MAPPEDFILE_HH
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Plik zmapowany w pamieci tylko do odczytu (mmap), zawartosc dostepna jako ciagly bufor znakow
+ * bez kopiowania do buforow strumieni
+ */
+class MappedFile {
+public:
+    /**
+     * Mapuje podany plik
+     * @param path
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Przejmuje mapowanie
+     * @param file
+     */
+    MappedFile(MappedFile&& file) noexcept;
+
+    /**
+     * Zwalnia mapowanie
+     */
+    ~MappedFile();
+
+    /**
+     * Zwraca wskaznik na poczatek pliku
+     * @return wskaznik
+     */
+    const char* data() const;
+
+    /**
+     * Zwraca rozmiar pliku
+     * @return rozmiar w bajtach
+     */
+    size_t size() const;
+
+    /**
+     * Informuje system, ze strony przed podanym przesunieciem nie beda juz czytane, dzieki czemu
+     * przy czytaniu po kolei pamiec zajeta przez plik nie rosnie z jego rozmiarem
+     * @param offset
+     */
+    void release(size_t offset);
+
+private:
+    const char* mapping = nullptr; /** Poczatek mapowania */
+    size_t length = 0; /** Rozmiar pliku */
+    size_t released = 0; /** Przesuniecie, do ktorego strony zostaly juz zwolnione */
+};
+
+#endif //ZAD3_MAPPEDFILE_HH
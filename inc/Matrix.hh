@@ -6,10 +6,13 @@
 
 #include "../inc/Complex.hh"
 #include "../inc/Vector.hh"
+#include "../inc/Factorization.hh"
+#include "../inc/MatrixView.hh"
 
 /* na niektorych platformach przykrywa uzywana tu nazwe */
 #ifdef minor
 #undef minor
+#endif
 
 /**
  * Klasa reprezentujaca macierz dwuwymiarowa o skalarach T i rozmiarze size
@@ -20,43 +23,99 @@ template <class T, size_t size>
 class Matrix {
 
 public:
+    using scalar_type = T; /** Typ skalara */
+    using vector_type = Vector<T, size>; /** Typ wektora o dlugosci rownej liczbie wierszy */
+
     /**
      * Tworzy macierz o wszystkich skalarach rownych podanemu
      * @param scalar
      */
-    explicit Matrix(T scalar);
+    constexpr explicit Matrix(T scalar);
 
     /**
      * Tworzy macierz zerowa
      */
-    Matrix() = default;
+    constexpr Matrix() = default;
+
+    /**
+     * Tworzy macierz przepisujac skalary z widoku
+     * @param view
+     */
+    template <class D>
+    Matrix(const MatrixView<D>& view);
+
+    /**
+     * Zwraca liczbe wierszy
+     * @return liczba wierszy
+     */
+    static constexpr size_t rows();
+
+    /**
+     * Zwraca liczbe kolumn
+     * @return liczba kolumn
+     */
+    static constexpr size_t columns();
 
     /**
      * Wylicza wyznacznik
      * @return wartosc
      */
-    T det() const;
+    constexpr T det() const;
 
     /**
      * Transpozycjonuje macierz
      * @return macierz transponowana
      */
-    Matrix<T, size> transpose() const;
+    constexpr Matrix<T, size> transpose() const;
+
+    /**
+     * Tworzy widok na transpozycje macierzy bez przepisywania skalarow
+     * @return widok
+     */
+    TransposedView<const Matrix<T, size>> transposed() const;
 
     /**
-     * Podmienia j-ta kolumne macierzy na wektor
+     * Tworzy widok na macierz z j-ta kolumna podmieniona na wektor
      * @param vector
      * @param j
-     * @return macierz z podmieniona j-ta kolumna
+     * @return widok
+     */
+    ReplacedColumnView<Matrix<T, size>, Vector<T, size>> replace_column(const Vector<T, size>& vector, size_t j) const;
+
+    /**
+     * Widok przechowuje wskaznik na wektor, wiec nie moze powstac z wektora tymczasowego
+     * (takze z wyrazenia wektorowego)
+     */
+    void replace_column(Vector<T, size>&& vector, size_t j) const = delete;
+
+    /**
+     * Tworzy widok na x-ty wiersz macierzy
+     * @param x
+     * @return widok
+     */
+    RowView<const Matrix<T, size>> row(size_t x) const;
+
+    /**
+     * Tworzy widok na y-ta kolumne macierzy
+     * @param y
+     * @return widok
      */
-    Matrix<T, size> replace_column(const Vector<T, size>& vector, size_t j) const;
+    ColumnView<const Matrix<T, size>> column(size_t y) const;
 
     /**
      * Operator mnozenia macierzy przez wektor
      * @param vector
-     * @return wektor
+     * @return wyrazenie wektorowe
+     */
+    constexpr MatrixVectorProduct<Matrix<T, size>, Vector<T, size>> operator*(const Vector<T, size>& vector) const;
+
+    /**
+     * Operator mnozenia macierzy przez wyrazenie wektorowe (np. widok wiersza lub kolumny)
+     * @param expression
+     * @return wyrazenie wektorowe
      */
-    Vector<T, size> operator*(const Vector<T, size>& vector) const;
+    template <class E>
+    constexpr MatrixVectorProduct<Matrix<T, size>, E> operator*(const VectorExpression<E>& expression) const;
 
     /**
      * Operator indeksowania macierzy ze sprawdzaniem granic
@@ -77,16 +136,16 @@ public:
     /**
      * Operator indeksowania macierzy
      * @param x
-     * @return x-ty wiersz w macierzy jako wektor
+     * @return referencje na x-ty wiersz w macierzy jako wektor
      */
-    Vector<T, size> operator[](size_t x) const;
+    constexpr const Vector<T, size>& operator[](size_t x) const;
 
     /**
      * Operator indeksowania macierzy
      * @param x
      * @return referencje na x-ty wiersz w macierzy jako wektor
      */
-    Vector<T, size>& operator[](size_t x);
+    constexpr Vector<T, size>& operator[](size_t x);
 
     /**
      * Operator indeksowania macierzy ze sprawdzaniem granic
@@ -121,7 +180,7 @@ public:
     friend std::ostream& operator<<(std::ostream& out, const Matrix<_T, _size>& matrix);
 
 private:
-    Vector<T, size> vectors[size];
+    Vector<T, size> vectors[size]{};
 };
 
 /**
@@ -138,7 +197,7 @@ struct Operations {
      * @param j
      * @return minor macierzy
      */
-    static Matrix<T, size - 1> minor(const Matrix<T, size>& matrix, size_t i, size_t j) {
+    static constexpr Matrix<T, size - 1> minor(const Matrix<T, size>& matrix, size_t i, size_t j) {
         Matrix<T, size - 1> result;
 
         for (size_t x = 0; x < i; x++)
@@ -161,46 +220,109 @@ struct Operations {
     }
 
     /**
-     * Wylicza wyznacznik
+     * Wylicza wyznacznik eliminacja Gaussa z czesciowym wyborem elementu glownego
      * @param matrix
      * @return wartosc
      */
-    static T det(const Matrix<T, size>& matrix) {
-        static constexpr Operations<T, size - 1> operations;
-
-        T result = 0;
-        for (size_t i = 0; i < size; i++)
-            result += (matrix[0][i] * static_cast<double>(std::pow(-1, i)) * operations.det(minor(matrix, 0, i)));
-
-        return result;
+    static constexpr T det(const Matrix<T, size>& matrix) {
+        Matrix<T, size> result = matrix;
+        return Factorization<T>::eliminate(result, size);
     }
 };
 
 /**
- * Czesciowa specjalizacja powyzszej struktury
+ * Czesciowa specjalizacja powyzszej struktury, wzor jawny dla macierzy 2x2
  * @tparam T
  */
 template <class T>
 struct Operations<T, 2> {
-    static T det(const Matrix<T, 2>& matrix) {
+    static constexpr T det(const Matrix<T, 2>& matrix) {
         return (matrix[0][0] * matrix[1][1]) - (matrix[1][0] * matrix[0][1]);
     }
 };
 
+/**
+ * Czesciowa specjalizacja powyzszej struktury dla macierzy 3x3,
+ * rozwiniecie Laplace'a wzgledem pierwszego wiersza (dopelnienia algebraiczne 2x2)
+ * @tparam T
+ */
+template <class T>
+struct Operations<T, 3> {
+    static constexpr T det(const Matrix<T, 3>& matrix) {
+        return matrix[0][0] * (matrix[1][1] * matrix[2][2] - matrix[2][1] * matrix[1][2])
+             - matrix[0][1] * (matrix[1][0] * matrix[2][2] - matrix[2][0] * matrix[1][2])
+             + matrix[0][2] * (matrix[1][0] * matrix[2][1] - matrix[2][0] * matrix[1][1]);
+    }
+};
+
+/**
+ * Czesciowa specjalizacja powyzszej struktury dla macierzy 4x4,
+ * rozwiniecie Laplace'a wzgledem dwoch pierwszych wierszy (minory 2x2)
+ * @tparam T
+ */
+template <class T>
+struct Operations<T, 4> {
+    static constexpr T det(const Matrix<T, 4>& matrix) {
+        const Vector<T, 4>& a = matrix[0];
+        const Vector<T, 4>& b = matrix[1];
+        const Vector<T, 4>& c = matrix[2];
+        const Vector<T, 4>& d = matrix[3];
+
+        const T s0 = a[0] * b[1] - b[0] * a[1];
+        const T s1 = a[0] * b[2] - b[0] * a[2];
+        const T s2 = a[0] * b[3] - b[0] * a[3];
+        const T s3 = a[1] * b[2] - b[1] * a[2];
+        const T s4 = a[1] * b[3] - b[1] * a[3];
+        const T s5 = a[2] * b[3] - b[2] * a[3];
+
+        const T c0 = c[0] * d[1] - d[0] * c[1];
+        const T c1 = c[0] * d[2] - d[0] * c[2];
+        const T c2 = c[0] * d[3] - d[0] * c[3];
+        const T c3 = c[1] * d[2] - d[1] * c[2];
+        const T c4 = c[1] * d[3] - d[1] * c[3];
+        const T c5 = c[2] * d[3] - d[2] * c[3];
+
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+};
+
 template <class T, size_t size>
-Matrix<T, size>::Matrix(T scalar) {
+constexpr Matrix<T, size>::Matrix(T scalar) {
     for (size_t i = 0; i < size; i++)
         vectors[i] = Vector<T, size>(scalar);
 }
 
 template <class T, size_t size>
-T Matrix<T, size>::det() const {
-    static constexpr Operations<T, size> operations;
-    return operations.det(*this);
+template <class D>
+Matrix<T, size>::Matrix(const MatrixView<D>& view) {
+    const D& matrix = view.derived();
+    if (matrix.rows() != size || matrix.columns() != size)
+        throw std::runtime_error("Size mismatch");
+
+    for (size_t x = 0; x < size; x++) {
+        const auto row = matrix[x];
+        for (size_t y = 0; y < size; y++)
+            vectors[x][y] = row[y];
+    }
+}
+
+template <class T, size_t size>
+constexpr size_t Matrix<T, size>::rows() {
+    return size;
+}
+
+template <class T, size_t size>
+constexpr size_t Matrix<T, size>::columns() {
+    return size;
+}
+
+template <class T, size_t size>
+constexpr T Matrix<T, size>::det() const {
+    return Operations<T, size>::det(*this);
 }
 
 template <class T, size_t size>
-Matrix<T, size>  Matrix<T, size>::transpose() const {
+constexpr Matrix<T, size> Matrix<T, size>::transpose() const {
     Matrix<T, size> result;
     for (size_t x = 0; x < size; x++)
         for (size_t y = 0; y < size; y++)
@@ -209,26 +331,40 @@ Matrix<T, size>  Matrix<T, size>::transpose() const {
 }
 
 template <class T, size_t size>
-Matrix<T, size> Matrix<T, size>::replace_column(const Vector<T, size> &vector, const size_t j) const {
-    Matrix<T, size> result;
-    for (size_t x = 0; x < size; x++) {
-        for (size_t y = 0; y < j; y++)
-            result[x][y] = vectors[x][y];
+TransposedView<const Matrix<T, size>> Matrix<T, size>::transposed() const {
+    return TransposedView<const Matrix<T, size>>(*this);
+}
 
-        result[x][j] = vector[x];
+template <class T, size_t size>
+ReplacedColumnView<Matrix<T, size>, Vector<T, size>> Matrix<T, size>::replace_column(const Vector<T, size> &vector, const size_t j) const {
+    if (j >= size)
+        throw std::runtime_error("Index out of range");
+    return ReplacedColumnView<Matrix<T, size>, Vector<T, size>>(*this, vector, j);
+}
 
-        for (size_t y = j + 1; y < size; y++)
-            result[x][y] = vectors[x][y];
-    }
-    return result;
+template <class T, size_t size>
+RowView<const Matrix<T, size>> Matrix<T, size>::row(const size_t x) const {
+    if (x >= size)
+        throw std::runtime_error("Index out of range");
+    return RowView<const Matrix<T, size>>(*this, x);
 }
 
 template <class T, size_t size>
-Vector<T, size> Matrix<T, size>::operator*(const Vector<T, size> &vector) const {
-    Vector<T, size> result;
-    for (size_t i = 0; i < size; i++)
-        result[i] = vectors[i].dot(vector);
-    return result;
+ColumnView<const Matrix<T, size>> Matrix<T, size>::column(const size_t y) const {
+    if (y >= size)
+        throw std::runtime_error("Index out of range");
+    return ColumnView<const Matrix<T, size>>(*this, y);
+}
+
+template <class T, size_t size>
+constexpr MatrixVectorProduct<Matrix<T, size>, Vector<T, size>> Matrix<T, size>::operator*(const Vector<T, size> &vector) const {
+    return MatrixVectorProduct<Matrix<T, size>, Vector<T, size>>(*this, vector);
+}
+
+template <class T, size_t size>
+template <class E>
+constexpr MatrixVectorProduct<Matrix<T, size>, E> Matrix<T, size>::operator*(const VectorExpression<E>& expression) const {
+    return MatrixVectorProduct<Matrix<T, size>, E>(*this, expression.derived());
 }
 
 template <class T, size_t size>
@@ -260,12 +396,12 @@ Vector<T, size>& Matrix<T, size>::operator()(const size_t x) {
 }
 
 template <class T, size_t size>
-Vector<T, size> Matrix<T, size>::operator[](const size_t x) const {
+constexpr const Vector<T, size>& Matrix<T, size>::operator[](const size_t x) const {
     return vectors[x];
 }
 
 template <class T, size_t size>
-Vector<T, size>& Matrix<T, size>::operator[](const size_t x) {
+constexpr Vector<T, size>& Matrix<T, size>::operator[](const size_t x) {
     return vectors[x];
 }
 
@@ -286,6 +422,16 @@ inline std::ostream& operator<<(std::ostream& out, const Matrix<T, size>& matrix
     return out;
 }
 
+/**
+ * Macierze sa argumentami wyrazen przechowywanymi przez referencje
+ * @tparam T
+ * @tparam size
+ */
+template <class T, size_t size>
+struct ExpressionOperand<Matrix<T, size>> {
+    using type = const Matrix<T, size>&;
+};
+
 using Matrix5d = Matrix<double, 5>; /** Alias dla macierzy 5x5 liczb rzeczywistych */
 using Matrix5c = Matrix<Complex<double>, 5>; /** Alias dla macierzy 5x5 liczb zespolonych */
 
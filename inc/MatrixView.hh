@@ -0,0 +1,398 @@
+#ifndef ZAD3_MATRIXVIEW_HH
+#define ZAD3_MATRIXVIEW_HH
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../inc/VectorExpression.hh"
+
+/* widoki nie kopiuja skalarow, przechowuja jedynie wskaznik na macierz (lub wektor),
+ * dlatego nie moga jej przezyc */
+
+/**
+ * Informuje, czy macierz M ma rozmiar ustalany w czasie wykonania
+ * @tparam M
+ */
+template <class M>
+struct Resizable : std::false_type {};
+
+/**
+ * Wczytuje skalary z pierwszego niepustego wiersza strumienia
+ * @param in
+ * @param row
+ * @return strumien ze stanem bledu ustawionym, gdy wiersz jest pusty lub niepoprawny
+ */
+template <class T>
+std::istream& read_row(std::istream& in, std::vector<T>& row) {
+    std::string line;
+    if (!std::getline(in >> std::ws, line))
+        return in;
+
+    std::istringstream scalars(line);
+    T scalar;
+    while (scalars >> scalar)
+        row.push_back(scalar);
+
+    if (row.empty() || !scalars.eof())
+        in.setstate(std::ios::failbit);
+    return in;
+}
+
+/**
+ * Baza widokow macierzy, pozwala odroznic widoki od innych typow w przeciazeniach
+ * @tparam Derived
+ */
+template <class Derived>
+struct MatrixView {
+    /**
+     * Zwraca widok jako typ pochodny
+     * @return referencja na widok
+     */
+    const Derived& derived() const {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+/**
+ * Widok na x-ty wiersz macierzy M, jest wyrazeniem wektorowym (VectorExpression.hh)
+ * @tparam M
+ */
+template <class M>
+class RowView : public VectorExpression<RowView<M>> {
+public:
+    using scalar_type = typename std::remove_const_t<M>::scalar_type;
+
+    /**
+     * Tworzy widok na x-ty wiersz macierzy
+     * @param matrix
+     * @param x
+     */
+    RowView(M& matrix, size_t x) : matrix(&matrix), x(x) {}
+
+    /**
+     * Zwraca dlugosc wiersza
+     * @return dlugosc
+     */
+    size_t length() const {
+        return matrix->columns();
+    }
+
+    /**
+     * Operator indeksowania wiersza
+     * @param y
+     * @return skalar (lub referencja na skalar) w y-tej kolumnie
+     */
+    decltype(auto) operator[](size_t y) const {
+        return (*matrix)[x][y];
+    }
+
+    /**
+     * Operator indeksowania wiersza ze sprawdzaniem granic
+     * @param y
+     * @return skalar (lub referencja na skalar) w y-tej kolumnie
+     */
+    decltype(auto) operator()(size_t y) const {
+        if (y >= length())
+            throw std::runtime_error("Index out of range");
+        return (*matrix)[x][y];
+    }
+
+    /**
+     * Skalar wiersza czytany jest tylko przy wyliczaniu skalaru o tym samym indeksie, wiec przypisanie
+     * nie wymaga wektora tymczasowego, nawet do wiersza tej samej macierzy
+     * @see ExpressionOperand::aliases
+     */
+    bool aliases(const void*) const {
+        return false;
+    }
+
+private:
+    M* matrix;
+    size_t x;
+};
+
+/**
+ * Widok na y-ta kolumne macierzy M, jest wyrazeniem wektorowym (VectorExpression.hh)
+ * @tparam M
+ */
+template <class M>
+class ColumnView : public VectorExpression<ColumnView<M>> {
+public:
+    using scalar_type = typename std::remove_const_t<M>::scalar_type;
+
+    /**
+     * Tworzy widok na y-ta kolumne macierzy
+     * @param matrix
+     * @param y
+     */
+    ColumnView(M& matrix, size_t y) : matrix(&matrix), y(y) {}
+
+    /**
+     * Zwraca dlugosc kolumny
+     * @return dlugosc
+     */
+    size_t length() const {
+        return matrix->rows();
+    }
+
+    /**
+     * Operator indeksowania kolumny
+     * @param x
+     * @return skalar (lub referencja na skalar) w x-tym wierszu
+     */
+    decltype(auto) operator[](size_t x) const {
+        return (*matrix)[x][y];
+    }
+
+    /**
+     * Operator indeksowania kolumny ze sprawdzaniem granic
+     * @param x
+     * @return skalar (lub referencja na skalar) w x-tym wierszu
+     */
+    decltype(auto) operator()(size_t x) const {
+        if (x >= length())
+            throw std::runtime_error("Index out of range");
+        return (*matrix)[x][y];
+    }
+
+    /**
+     * Skalary kolumny leza w wielu wierszach macierzy, wiec przypisanie do wiersza tej samej macierzy
+     * nadpisywaloby skalary jeszcze nieprzeczytane; przypisanie zawsze przez wektor tymczasowy
+     * @see ExpressionOperand::aliases
+     */
+    bool aliases(const void*) const {
+        return true;
+    }
+
+private:
+    M* matrix;
+    size_t y;
+};
+
+/**
+ * Widok na macierz transponowana, nie przepisuje skalarow
+ * @tparam M
+ */
+template <class M>
+class TransposedView : public MatrixView<TransposedView<M>> {
+public:
+    using scalar_type = typename std::remove_const_t<M>::scalar_type;
+    using vector_type = typename std::remove_const_t<M>::vector_type;
+
+    /**
+     * Tworzy widok na transpozycje macierzy
+     * @param matrix
+     */
+    explicit TransposedView(M& matrix) : matrix(&matrix) {}
+
+    /**
+     * Zwraca liczbe wierszy widoku
+     * @return liczba wierszy
+     */
+    size_t rows() const {
+        return matrix->columns();
+    }
+
+    /**
+     * Zwraca liczbe kolumn widoku
+     * @return liczba kolumn
+     */
+    size_t columns() const {
+        return matrix->rows();
+    }
+
+    /**
+     * Operator indeksowania widoku
+     * @param x
+     * @return x-ty wiersz widoku (x-ta kolumna macierzy)
+     */
+    ColumnView<M> operator[](size_t x) const {
+        return ColumnView<M>(*matrix, x);
+    }
+
+    /**
+     * Zwraca macierz, na ktora wskazuje widok
+     * @return referencja na macierz
+     */
+    M& base() const {
+        return *matrix;
+    }
+
+private:
+    M* matrix;
+};
+
+/**
+ * Wiersz widoku macierzy z podmieniona kolumna
+ * @tparam M
+ * @tparam V
+ */
+template <class M, class V>
+class ReplacedRowView {
+public:
+    using scalar_type = typename std::remove_const_t<M>::scalar_type;
+
+    /**
+     * Tworzy widok na x-ty wiersz
+     * @param matrix
+     * @param vector
+     * @param x
+     * @param j
+     */
+    ReplacedRowView(const M& matrix, const V& vector, size_t x, size_t j) : matrix(&matrix), vector(&vector), x(x), j(j) {}
+
+    /**
+     * Operator indeksowania wiersza
+     * @param y
+     * @return skalar w y-tej kolumnie
+     */
+    scalar_type operator[](size_t y) const {
+        return y == j ? (*vector)[x] : (*matrix)[x][y];
+    }
+
+private:
+    const M* matrix;
+    const V* vector;
+    size_t x;
+    size_t j;
+};
+
+/**
+ * Widok na macierz z j-ta kolumna podmieniona na wektor, nie przepisuje skalarow
+ * @tparam M
+ * @tparam V
+ */
+template <class M, class V>
+class ReplacedColumnView : public MatrixView<ReplacedColumnView<M, V>> {
+public:
+    using scalar_type = typename std::remove_const_t<M>::scalar_type;
+    using vector_type = typename std::remove_const_t<M>::vector_type;
+
+    /**
+     * Tworzy widok
+     * @param matrix
+     * @param vector
+     * @param j
+     */
+    ReplacedColumnView(const M& matrix, const V& vector, size_t j) : matrix(&matrix), vector(&vector), j(j) {}
+
+    /**
+     * Zwraca liczbe wierszy widoku
+     * @return liczba wierszy
+     */
+    size_t rows() const {
+        return matrix->rows();
+    }
+
+    /**
+     * Zwraca liczbe kolumn widoku
+     * @return liczba kolumn
+     */
+    size_t columns() const {
+        return matrix->columns();
+    }
+
+    /**
+     * Operator indeksowania widoku
+     * @param x
+     * @return x-ty wiersz widoku
+     */
+    ReplacedRowView<M, V> operator[](size_t x) const {
+        return ReplacedRowView<M, V>(*matrix, *vector, x, j);
+    }
+
+private:
+    const M* matrix;
+    const V* vector;
+    size_t j;
+};
+
+/**
+ * Tworzy widok na transpozycje macierzy
+ * @param matrix
+ * @return widok
+ */
+template <class M>
+TransposedView<M> transposed(M& matrix) {
+    return TransposedView<M>(matrix);
+}
+
+/**
+ * Operator mnozenia widoku macierzy przez wektor
+ * @param view
+ * @param vector
+ * @return wyrazenie wektorowe
+ */
+template <class D>
+MatrixVectorProduct<D, typename D::vector_type> operator*(const MatrixView<D>& view, const typename D::vector_type& vector) {
+    return MatrixVectorProduct<D, typename D::vector_type>(view.derived(), vector);
+}
+
+/**
+ * Operator mnozenia widoku macierzy przez wyrazenie wektorowe (np. widok wiersza)
+ * @param view
+ * @param expression
+ * @return wyrazenie wektorowe
+ */
+template <class D, class E>
+MatrixVectorProduct<D, E> operator*(const MatrixView<D>& view, const VectorExpression<E>& expression) {
+    return MatrixVectorProduct<D, E>(view.derived(), expression.derived());
+}
+
+/**
+ * Przeladowany operator wejscia, wczytuje macierz transponowana wprost na odpowiednie pozycje;
+ * pusta macierz o rozmiarze ustalanym w czasie wykonania dostaje rozmiar z liczby skalarow w pierwszym wierszu
+ * @param in
+ * @param view
+ */
+template <class M>
+std::istream& operator>>(std::istream& in, TransposedView<M> view) {
+    using T = typename TransposedView<M>::scalar_type;
+    M& matrix = view.base();
+    size_t x = 0;
+
+    if constexpr (Resizable<M>::value) {
+        if (matrix.rows() == 0) {
+            std::vector<T> first_row;
+            if (!read_row(in, first_row))
+                return in;
+
+            matrix = M(first_row.size(), first_row.size());
+            for (size_t y = 0; y < first_row.size(); y++)
+                matrix[y][0] = first_row[y];
+            x = 1;
+        }
+    }
+
+    for (; x < view.rows(); x++)
+        for (size_t y = 0; y < view.columns(); y++)
+            in >> matrix[y][x];
+    return in;
+}
+
+/**
+ * Przeladowany operator wyjscia
+ * @param out
+ * @param view
+ */
+template <class D>
+std::ostream& operator<<(std::ostream& out, const MatrixView<D>& view) {
+    const D& matrix = view.derived();
+    for (size_t x = 0; x < matrix.rows(); x++) {
+        const auto row = matrix[x];
+        for (size_t y = 0; y < matrix.columns(); y++) {
+            out << row[y];
+            if (y < matrix.columns() - 1)
+                out << " ";
+        }
+        if (x < matrix.rows() - 1)
+            out << "\n";
+    }
+    return out;
+}
+
+#endif //ZAD3_MATRIXVIEW_HH
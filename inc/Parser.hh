@@ -0,0 +1,334 @@
+#ifndef ZAD3_PARSER_HH
+#define ZAD3_PARSER_HH
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "../inc/Complex.hh"
+#include "../inc/MatrixView.hh"
+#include "../inc/SparseMatrix.hh"
+#include "../inc/Instrumentation.hh"
+
+/* format plikow rownanie_liniowe_*.dat: znak ciala (r lub z), n wierszy macierzy A^T po n skalarow
+ * i n skalarow wektora b; parser czyta wprost z ciaglego bufora przez std::from_chars, bez strumieni
+ * i bez alokacji na kazdy skalar */
+
+/**
+ * Blad parsowania z polozeniem w buforze
+ */
+class ParseError : public std::runtime_error {
+public:
+    /**
+     * Tworzy blad
+     * @param message
+     * @param position przesuniecie od poczatku bufora
+     * @param line numer wiersza (od 1)
+     * @param column numer kolumny (od 1)
+     */
+    ParseError(const std::string& message, size_t position, size_t line, size_t column)
+            : std::runtime_error("Parse error at line " + std::to_string(line) + ", column " + std::to_string(column)
+                                 + ": " + message),
+              position(position), line(line), column(column) {}
+
+    const size_t position; /** Przesuniecie od poczatku bufora */
+    const size_t line; /** Numer wiersza */
+    const size_t column; /** Numer kolumny */
+};
+
+/**
+ * Wczytywanie pojedynczego skalara T z bufora, przesuwa kursor za wczytany skalar
+ * @tparam T
+ */
+template <class T>
+struct ScalarParser {
+    /**
+     * Wczytuje liczbe, dopuszcza jawny znak + (jak operator>>)
+     * @param cursor
+     * @param end
+     * @param value
+     * @return false jesli w miejscu kursora nie ma liczby
+     */
+    static bool parse(const char*& cursor, const char* end, T& value) {
+        const char* first = cursor;
+        if (first != end && *first == '+')
+            first++;
+        if (first != end && *first == '-' && cursor != first)
+            return false;
+
+        const std::from_chars_result result = std::from_chars(first, end, value);
+        if (result.ec != std::errc())
+            return false;
+
+        cursor = result.ptr;
+        return true;
+    }
+};
+
+/**
+ * Czesciowa specjalizacja dla liczb zespolonych w formacie (re+imi), dopuszcza biale znaki
+ * miedzy czesciami jak operator>>
+ * @tparam T
+ */
+template <class T>
+struct ScalarParser<Complex<T>> {
+    static bool parse(const char*& cursor, const char* end, Complex<T>& value) {
+        const char* current = cursor;
+
+        if (!expect(current, end, Complex<T>::opening_parenthesis))
+            return false;
+
+        skip_blanks(current, end);
+        if (!ScalarParser<T>::parse(current, end, value.real))
+            return false;
+
+        skip_blanks(current, end);
+        if (current == end || (*current != '+' && *current != '-'))
+            return false;
+        const bool negative = *current++ == '-';
+
+        /* dokladnie jeden znak przed czescia urojona: (1+-2i) i (1++2i) sa bledne */
+        skip_blanks(current, end);
+        if (current != end && (*current == '+' || *current == '-'))
+            return false;
+        if (!ScalarParser<T>::parse(current, end, value.imaginary))
+            return false;
+        if (negative)
+            value.imaginary = -value.imaginary;
+
+        skip_blanks(current, end);
+        if (!expect(current, end, Complex<T>::i))
+            return false;
+
+        skip_blanks(current, end);
+        if (!expect(current, end, Complex<T>::closing_parenthesis))
+            return false;
+
+        cursor = current;
+        return true;
+    }
+
+private:
+    static void skip_blanks(const char*& cursor, const char* end) {
+        while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+            cursor++;
+    }
+
+    static bool expect(const char*& cursor, const char* end, const char c) {
+        if (cursor == end || *cursor != c)
+            return false;
+        cursor++;
+        return true;
+    }
+};
+
+/**
+ * Parser formatu .dat na ciaglym buforze znakow; bufor musi zyc dluzej niz parser
+ */
+class Parser {
+public:
+    /**
+     * Tworzy parser bufora [begin, end)
+     * @param begin
+     * @param end
+     */
+    Parser(const char* begin, const char* end) : begin(begin), cursor(begin), end(end) {}
+
+    /**
+     * Tworzy parser calego napisu
+     * @param buffer
+     */
+    explicit Parser(const std::string& buffer) : Parser(buffer.data(), buffer.data() + buffer.size()) {}
+
+    /**
+     * Zwraca przesuniecie kursora od poczatku bufora
+     * @return przesuniecie
+     */
+    size_t position() const {
+        return cursor - begin;
+    }
+
+    /**
+     * Sprawdza, czy poza bialymi znakami nic w buforze nie zostalo
+     * @return true jesli bufor jest wyczerpany
+     */
+    bool done() {
+        skip_whitespace();
+        return cursor == end;
+    }
+
+    /**
+     * Wczytuje znak ciala liczb (r lub z), nie sprawdza jego poprawnosci
+     * @return znak
+     */
+    char field() {
+        skip_whitespace();
+        if (cursor == end)
+            fail("expected field tag");
+        return *cursor++;
+    }
+
+    /**
+     * Wczytuje jeden skalar, po ktorym musi byc bialy znak lub koniec bufora (2x nie jest liczba 2)
+     * @param value
+     */
+    template <class T>
+    void scalar(T& value) {
+        skip_whitespace();
+        if (!ScalarParser<T>::parse(cursor, end, value))
+            fail("expected number");
+        if (cursor != end && !whitespace(*cursor))
+            fail("unexpected character after number");
+    }
+
+    /**
+     * Wczytuje macierz zapisana kolumnami (kolejne wiersze wejscia to kolumny macierzy); macierz
+     * pusta o zmiennym rozmiarze staje sie kwadratowa o rozmiarze rownym liczbie skalarow w pierwszym wierszu
+     * @param matrix
+     */
+    template <class M>
+    void transposed(M& matrix);
+
+    /**
+     * Wczytuje macierz rzadka zapisana kolumnami jak transposed(M&), zapamietujac tylko niezerowe skalary
+     * @param matrix
+     */
+    template <class T>
+    void transposed(SparseMatrix<T>& matrix);
+
+    /**
+     * Wczytuje tyle skalarow, ile wynosi dlugosc wektora
+     * @param vector
+     */
+    template <class V>
+    void vector(V& vector) {
+        for (size_t i = 0; i < vector.length(); i++)
+            scalar(vector[i]);
+    }
+
+    /**
+     * Wczytuje macierz A^T i wektor b rownania (bez znaku ciala), dla rownania o zmiennym rozmiarze
+     * wektor b dostaje dlugosc rowna rozmiarowi macierzy
+     * @param equation
+     */
+    template <class E>
+    void equation(E& equation) {
+        ZAD3_PHASE(Phase::parse, 0, 0);
+        [[maybe_unused]] const char* const first = cursor;
+        transposed(equation.factor_matrix);
+
+        if constexpr (Resizable<std::decay_t<decltype(equation.factor_matrix)>>::value)
+            equation.result_vector = std::decay_t<decltype(equation.result_vector)>(equation.size());
+
+        vector(equation.result_vector);
+        ZAD3_BYTES(cursor - first);
+    }
+
+    /**
+     * Zglasza blad w miejscu kursora
+     * @param message
+     */
+    [[noreturn]] void fail(const std::string& message) const {
+        size_t line = 1, column = 1;
+        for (const char* c = begin; c != cursor; c++) {
+            if (*c == '\n') {
+                line++;
+                column = 1;
+            } else {
+                column++;
+            }
+        }
+        throw ParseError(message, position(), line, column);
+    }
+
+private:
+    const char* begin; /** Poczatek bufora */
+    const char* cursor; /** Biezaca pozycja */
+    const char* end; /** Koniec bufora */
+
+    static bool whitespace(const char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    void skip_whitespace() {
+        while (cursor != end && whitespace(*cursor))
+            cursor++;
+    }
+
+    /**
+     * Pomija spacje i tabulatory, zatrzymuje sie na koncu wiersza
+     * @return true jesli kursor jest na koncu wiersza lub bufora
+     */
+    bool end_of_line() {
+        while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
+            cursor++;
+        return cursor == end || *cursor == '\n';
+    }
+};
+
+template <class M>
+void Parser::transposed(M& matrix) {
+    using T = typename M::scalar_type;
+
+    if constexpr (Resizable<M>::value) {
+        if (matrix.rows() == 0) {
+            skip_whitespace();
+
+            std::vector<T> column;
+            while (!end_of_line()) {
+                column.emplace_back();
+                scalar(column.back());
+            }
+            if (column.empty())
+                fail("expected number");
+
+            matrix = M(column.size(), column.size());
+            for (size_t x = 0; x < column.size(); x++)
+                matrix[x][0] = column[x];
+
+            for (size_t y = 1; y < matrix.columns(); y++)
+                for (size_t x = 0; x < matrix.rows(); x++)
+                    scalar(matrix[x][y]);
+            return;
+        }
+    }
+
+    for (size_t y = 0; y < matrix.columns(); y++)
+        for (size_t x = 0; x < matrix.rows(); x++)
+            scalar(matrix[x][y]);
+}
+
+template <class T>
+void Parser::transposed(SparseMatrix<T>& matrix) {
+    size_t rows = matrix.rows(), columns = matrix.columns();
+    std::vector<T> column;
+
+    if (rows == 0) {
+        skip_whitespace();
+        while (!end_of_line()) {
+            column.emplace_back();
+            scalar(column.back());
+        }
+        if (column.empty())
+            fail("expected number");
+        rows = columns = column.size();
+    }
+
+    SparseBuilder<T> builder(rows, columns);
+    for (size_t x = 0; x < column.size(); x++)
+        builder.add(x, 0, column[x]);
+
+    T value;
+    for (size_t y = column.empty() ? 0 : 1; y < columns; y++) {
+        for (size_t x = 0; x < rows; x++) {
+            scalar(value);
+            builder.add(x, y, value);
+        }
+    }
+    matrix = builder.build();
+}
+
+#endif //ZAD3_PARSER_HH
@@ -0,0 +1,240 @@
+#ifndef ZAD3_PRECONDITIONER_HH
+#define ZAD3_PRECONDITIONER_HH
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Scalar.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/SparseMatrix.hh"
+
+/* uwarunkowanie wstepne dla metod z Krylov.hh: apply(r) zwraca z ~ M^-1 r dla M przyblizajacego A */
+
+/**
+ * Brak uwarunkowania wstepnego (M = I)
+ * @tparam T
+ */
+template <class T>
+struct IdentityPreconditioner {
+    /**
+     * Zwraca wektor bez zmian
+     * @param vector
+     * @return wektor
+     */
+    DynamicVector<T> apply(const DynamicVector<T>& vector) const {
+        return vector;
+    }
+};
+
+/**
+ * Uwarunkowanie Jacobiego (M = diag(A))
+ * @tparam T
+ */
+template <class T>
+class JacobiPreconditioner {
+public:
+    /**
+     * Zapamietuje odwrotnosci przekatnej macierzy
+     * @param matrix
+     */
+    explicit JacobiPreconditioner(const DynamicMatrix<T>& matrix);
+
+    /**
+     * @see JacobiPreconditioner(const DynamicMatrix<T>&)
+     */
+    explicit JacobiPreconditioner(const SparseMatrix<T>& matrix);
+
+    /**
+     * Dzieli wektor przez przekatna
+     * @param vector
+     * @return wektor
+     */
+    DynamicVector<T> apply(const DynamicVector<T>& vector) const;
+
+private:
+    DynamicVector<T> inverse; /** Odwrotnosci skalarow przekatnej */
+};
+
+template <class T>
+JacobiPreconditioner<T>::JacobiPreconditioner(const DynamicMatrix<T>& matrix) : inverse(matrix.rows()) {
+    if (matrix.rows() != matrix.columns())
+        throw std::runtime_error("Matrix is not square");
+
+    for (size_t i = 0; i < matrix.rows(); i++) {
+        if (Scalar<T>::magnitude(matrix[i][i]) == 0)
+            throw std::runtime_error("Zero on diagonal");
+        inverse[i] = T(1) / matrix[i][i];
+    }
+}
+
+template <class T>
+JacobiPreconditioner<T>::JacobiPreconditioner(const SparseMatrix<T>& matrix) : inverse(matrix.rows()) {
+    if (matrix.rows() != matrix.columns())
+        throw std::runtime_error("Matrix is not square");
+
+    for (size_t i = 0; i < matrix.rows(); i++) {
+        const T diagonal = matrix(i, i);
+        if (Scalar<T>::magnitude(diagonal) == 0)
+            throw std::runtime_error("Zero on diagonal");
+        inverse[i] = T(1) / diagonal;
+    }
+}
+
+template <class T>
+DynamicVector<T> JacobiPreconditioner<T>::apply(const DynamicVector<T>& vector) const {
+    DynamicVector<T> result(vector.length());
+    for (size_t i = 0; i < vector.length(); i++)
+        result[i] = inverse[i] * vector[i];
+    return result;
+}
+
+/**
+ * Niepelny rozklad LU bez wypelnienia (ILU(0)): L i U maja niezerowe skalary tylko tam, gdzie A,
+ * wiec pamiec i czas apply sa proporcjonalne do liczby niezerowych skalarow A
+ * @tparam T
+ */
+template <class T>
+class ILUPreconditioner {
+public:
+    /**
+     * Rozklada niezerowe skalary macierzy
+     * @param matrix
+     */
+    explicit ILUPreconditioner(const DynamicMatrix<T>& matrix);
+
+    /**
+     * Rozklada macierz rzadka, dopisujac do wzorca brakujace skalary przekatnej
+     * @param matrix
+     */
+    explicit ILUPreconditioner(const SparseMatrix<T>& matrix);
+
+    /**
+     * Rozwiazuje LUz = r
+     * @param vector wektor r
+     * @return wektor z
+     */
+    DynamicVector<T> apply(const DynamicVector<T>& vector) const;
+
+private:
+    /* czynniki zapisane wierszami: skalary wiersza x to values[offsets[x]] .. values[offsets[x + 1] - 1],
+     * kolumny rosnaco w columns, L bez jedynek na przekatnej */
+
+    std::vector<T> values; /** Niezerowe skalary L i U */
+    std::vector<size_t> columns; /** Kolumny skalarow */
+    std::vector<size_t> offsets; /** Poczatki wierszy w values */
+    std::vector<size_t> diagonal; /** Polozenia skalarow przekatnej w values */
+
+    /**
+     * Rozklada skalary zapisane w values w miejscu
+     */
+    void factor();
+};
+
+template <class T>
+ILUPreconditioner<T>::ILUPreconditioner(const DynamicMatrix<T>& matrix) : offsets(1, 0) {
+    if (matrix.rows() != matrix.columns())
+        throw std::runtime_error("Matrix is not square");
+
+    const size_t n = matrix.rows();
+    diagonal.resize(n);
+    for (size_t x = 0; x < n; x++) {
+        for (size_t y = 0; y < n; y++) {
+            if (y == x)
+                diagonal[x] = values.size();
+            if (y == x || Scalar<T>::magnitude(matrix[x][y]) != 0) {
+                values.push_back(matrix[x][y]);
+                columns.push_back(y);
+            }
+        }
+        offsets.push_back(values.size());
+    }
+
+    factor();
+}
+
+template <class T>
+ILUPreconditioner<T>::ILUPreconditioner(const SparseMatrix<T>& matrix) : offsets(1, 0) {
+    if (matrix.rows() != matrix.columns())
+        throw std::runtime_error("Matrix is not square");
+
+    const size_t n = matrix.rows();
+    diagonal.resize(n);
+    values.reserve(matrix.nonzeros() + n);
+    columns.reserve(matrix.nonzeros() + n);
+
+    for (size_t x = 0; x < n; x++) {
+        bool placed = false;
+        for (size_t p = matrix.row_offsets()[x]; p < matrix.row_offsets()[x + 1]; p++) {
+            const size_t y = matrix.column_indices()[p];
+            if (!placed && y >= x) {
+                diagonal[x] = values.size();
+                placed = true;
+                if (y > x) {
+                    values.push_back(T());
+                    columns.push_back(x);
+                }
+            }
+            values.push_back(matrix.data()[p]);
+            columns.push_back(y);
+        }
+        if (!placed) {
+            diagonal[x] = values.size();
+            values.push_back(T());
+            columns.push_back(x);
+        }
+        offsets.push_back(values.size());
+    }
+
+    factor();
+}
+
+template <class T>
+void ILUPreconditioner<T>::factor() {
+    static const size_t none = std::numeric_limits<size_t>::max();
+
+    const size_t n = diagonal.size();
+    std::vector<size_t> position(n, none);
+
+    for (size_t x = 0; x < n; x++) {
+        for (size_t p = offsets[x]; p < offsets[x + 1]; p++)
+            position[columns[p]] = p;
+
+        for (size_t p = offsets[x]; p < diagonal[x]; p++) {
+            const size_t k = columns[p];
+            values[p] = values[p] / values[diagonal[k]];
+            for (size_t q = diagonal[k] + 1; q < offsets[k + 1]; q++)
+                if (position[columns[q]] != none)
+                    values[position[columns[q]]] -= values[p] * values[q];
+        }
+
+        if (Scalar<T>::magnitude(values[diagonal[x]]) == 0)
+            throw std::runtime_error("Zero pivot in incomplete factorization");
+
+        for (size_t p = offsets[x]; p < offsets[x + 1]; p++)
+            position[columns[p]] = none;
+    }
+}
+
+template <class T>
+DynamicVector<T> ILUPreconditioner<T>::apply(const DynamicVector<T>& vector) const {
+    const size_t n = diagonal.size();
+    if (vector.length() != n)
+        throw std::runtime_error("Size mismatch");
+
+    DynamicVector<T> result(vector);
+    for (size_t x = 0; x < n; x++)
+        for (size_t p = offsets[x]; p < diagonal[x]; p++)
+            result[x] -= values[p] * result[columns[p]];
+
+    for (size_t x = n; x-- > 0;) {
+        for (size_t p = diagonal[x] + 1; p < offsets[x + 1]; p++)
+            result[x] -= values[p] * result[columns[p]];
+        result[x] = result[x] / values[diagonal[x]];
+    }
+    return result;
+}
+
+#endif //ZAD3_PRECONDITIONER_HH
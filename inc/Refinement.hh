@@ -0,0 +1,118 @@
+#ifndef ZAD3_REFINEMENT_HH
+#define ZAD3_REFINEMENT_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "../inc/Scalar.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+
+/**
+ * Przebieg rozwiazania z poprawkami iteracyjnymi
+ * @tparam R typ czesci rzeczywistej skalara
+ */
+template <class R>
+struct RefinementReport {
+    size_t iterations = 0; /** Liczba wykonanych poprawek */
+    R residual = 0; /** Norma maksimum wektora bledu Ax-b zwroconego rozwiazania */
+    bool converged = false; /** false - poprawki nie osiagnely tolerancji i uklad rozwiazano w pelnej precyzji */
+};
+
+/**
+ * Operacje pomocnicze rozwiazania, w ktorym macierz rozkladana jest w pojedynczej precyzji,
+ * a wektor bledu i poprawki liczone sa w precyzji T
+ * @tparam T
+ */
+template <class T>
+struct Refinement {
+    using R = typename Scalar<T>::real_type;
+    using S = typename Scalar<T>::single_type;
+
+    static constexpr size_t max_iterations = 30; /** Domyslna najwieksza liczba poprawek */
+
+    /**
+     * Zwraca domyslna tolerancje: blad wzgledny osiagalny w precyzji T
+     * @param n rozmiar ukladu
+     * @return tolerancja
+     */
+    static R tolerance(const size_t n) {
+        return std::numeric_limits<R>::epsilon() * std::sqrt(static_cast<R>(n));
+    }
+
+    /**
+     * Wylicza norme maksimum wektora (modul jak przy wyborze elementu glownego); skladowa nieskonczona
+     * lub NaN daje norme nieskonczona lub NaN (std::max pominalby NaN)
+     * @param vector
+     * @return wartosc
+     */
+    static R norm(const DynamicVector<T>& vector) {
+        R result = 0;
+        for (size_t i = 0; i < vector.length(); i++) {
+            const R magnitude = Scalar<T>::magnitude(vector[i]);
+            if (!std::isfinite(magnitude))
+                return magnitude;
+            result = std::max(result, magnitude);
+        }
+        return result;
+    }
+
+    /**
+     * Wylicza norme macierzy indukowana norma maksimum (najwieksza suma modulow w wierszu)
+     * @param matrix
+     * @return wartosc
+     */
+    static R norm(const DynamicMatrix<T>& matrix) {
+        R result = 0;
+        for (size_t x = 0; x < matrix.rows(); x++) {
+            R sum = 0;
+            for (size_t y = 0; y < matrix.columns(); y++)
+                sum += Scalar<T>::magnitude(matrix[x][y]);
+            if (!std::isfinite(sum))
+                return sum;
+            result = std::max(result, sum);
+        }
+        return result;
+    }
+
+    /**
+     * Przepisuje macierz do pojedynczej precyzji
+     * @param matrix
+     * @return macierz
+     */
+    static DynamicMatrix<S> lower(const DynamicMatrix<T>& matrix) {
+        DynamicMatrix<S> result(matrix.rows(), matrix.columns());
+        for (size_t x = 0; x < matrix.rows(); x++)
+            for (size_t y = 0; y < matrix.columns(); y++)
+                result[x][y] = static_cast<S>(matrix[x][y]);
+        return result;
+    }
+
+    /**
+     * Przepisuje wektor do pojedynczej precyzji
+     * @param vector
+     * @return wektor
+     */
+    static DynamicVector<S> lower(const DynamicVector<T>& vector) {
+        DynamicVector<S> result(vector.length());
+        for (size_t i = 0; i < vector.length(); i++)
+            result[i] = static_cast<S>(vector[i]);
+        return result;
+    }
+
+    /**
+     * Przepisuje wektor z pojedynczej precyzji do precyzji T
+     * @param vector
+     * @return wektor
+     */
+    static DynamicVector<T> raise(const DynamicVector<S>& vector) {
+        DynamicVector<T> result(vector.length());
+        for (size_t i = 0; i < vector.length(); i++)
+            result[i] = static_cast<T>(vector[i]);
+        return result;
+    }
+};
+
+#endif //ZAD3_REFINEMENT_HH
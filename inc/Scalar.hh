@@ -0,0 +1,94 @@
+#ifndef ZAD3_SCALAR_HH
+#define ZAD3_SCALAR_HH
+
+#include "../inc/Complex.hh"
+
+/**
+ * Cechy skalara T wykorzystywane przez algorytmy numeryczne
+ * @tparam T
+ */
+template <class T>
+struct Scalar {
+    using real_type = T; /** Typ czesci rzeczywistej skalara */
+    using single_type = float; /** Skalar pojedynczej precyzji, w ktorej mozna rozkladac macierz */
+    static constexpr bool complex = false; /** Czy skalar jest liczba zespolona */
+
+    /**
+     * Wylicza modul skalara uzywany przy wyborze elementu glownego
+     * @param value
+     * @return wartosc
+     */
+    static constexpr real_type magnitude(const T& value) {
+        return value < 0 ? -value : value;
+    }
+
+    /**
+     * Wylicza sprzezenie skalara
+     * @param value
+     * @return wartosc
+     */
+    static constexpr T conjugate(const T& value) {
+        return value;
+    }
+
+    /**
+     * Zwraca czesc rzeczywista skalara
+     * @param value
+     * @return wartosc
+     */
+    static constexpr real_type real(const T& value) {
+        return value;
+    }
+
+    /**
+     * Wylicza wartosc bezwzgledna skalara
+     * @param value
+     * @return wartosc
+     */
+    static real_type absolute(const T& value) {
+        return magnitude(value);
+    }
+};
+
+/**
+ * Czesciowa specjalizacja powyzszej struktury dla liczb zespolonych
+ * @tparam T
+ */
+template <class T>
+struct Scalar<Complex<T>> {
+    using real_type = T; /** Typ czesci rzeczywistej skalara */
+    using single_type = Complex<float>; /** Skalar pojedynczej precyzji, w ktorej mozna rozkladac macierz */
+    static constexpr bool complex = true; /** Czy skalar jest liczba zespolona */
+
+    /**
+     * Wylicza |re| + |im|, do porownywania wystarcza i nie wymaga pierwiastka
+     * @param value
+     * @return wartosc
+     */
+    static constexpr real_type magnitude(const Complex<T>& value) {
+        return Scalar<T>::magnitude(value.real) + Scalar<T>::magnitude(value.imaginary);
+    }
+
+    /**
+     * @see Scalar::conjugate
+     */
+    static constexpr Complex<T> conjugate(const Complex<T>& value) {
+        return value.conjugate();
+    }
+
+    /**
+     * @see Scalar::real
+     */
+    static constexpr real_type real(const Complex<T>& value) {
+        return value.real;
+    }
+
+    /**
+     * @see Scalar::absolute
+     */
+    static real_type absolute(const Complex<T>& value) {
+        return static_cast<real_type>(value.abs());
+    }
+};
+
+#endif //ZAD3_SCALAR_HH
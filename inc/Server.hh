@@ -0,0 +1,102 @@
+#ifndef ZAD3_SERVER_HH
+#define ZAD3_SERVER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../inc/ThreadPool.hh"
+
+/* protokol serwera: zadania i odpowiedzi to ramki z 32-bajtowym naglowkiem i danymi o dlugosci
+ * podanej w naglowku, zapisane w porzadku bajtow maszyny jak plik binarny (BinaryFormat.hh); dane
+ * zadania to macierz A zapisana wierszami (pomijana z flaga request_reuse) i count wektorow b po size
+ * skalarow, dane odpowiedzi to count rozwiazan x; skalary to double lub Complex<double> (re, im).
+ * Zadania jednego polaczenia rozwiazywane sa rownolegle, a odpowiedzi wysylane w kolejnosci
+ * zakonczenia, z identyfikatorem zadania */
+
+/**
+ * Flagi zadania
+ */
+enum RequestFlags : uint8_t {
+    request_reuse = 1 /** Bez macierzy: uzyj rozkladu macierzy z ostatniego zadania polaczenia o tym ciele */
+};
+
+/**
+ * Wynik zadania
+ */
+enum class ResponseStatus : uint8_t {
+    solved = 0, /** Rozwiazania w danych odpowiedzi */
+    singular = 1, /** Macierz osobliwa, brak danych */
+    invalid = 2 /** Bledne zadanie (cialo, rozmiar, dlugosc, brak macierzy do ponownego uzycia), brak danych */
+};
+
+/**
+ * Naglowek ramki zadania
+ */
+struct RequestHeader {
+    char magic[4]; /** Sygnatura Z3RQ */
+    uint32_t length; /** Liczba bajtow danych po naglowku */
+    uint64_t id; /** Identyfikator odsylany w odpowiedzi */
+    uint8_t field; /** Znak ciala liczb (r lub z) */
+    uint8_t flags; /** RequestFlags */
+    uint8_t reserved[2]; /** Zarezerwowane, zera */
+    uint32_t size; /** Liczba niewiadomych */
+    uint32_t count; /** Liczba wektorow b */
+    uint32_t padding; /** Dopelnienie do 32 bajtow */
+};
+
+/**
+ * Naglowek ramki odpowiedzi
+ */
+struct ResponseHeader {
+    char magic[4]; /** Sygnatura Z3RS */
+    uint32_t length; /** Liczba bajtow danych po naglowku */
+    uint64_t id; /** Identyfikator zadania */
+    uint8_t status; /** ResponseStatus */
+    uint8_t reserved[3]; /** Zarezerwowane, zera */
+    uint32_t size; /** Liczba niewiadomych */
+    uint32_t count; /** Liczba rozwiazan */
+    uint32_t padding; /** Dopelnienie do 32 bajtow */
+};
+
+static_assert(sizeof(RequestHeader) == 32, "Request header must be 32 bytes");
+static_assert(sizeof(ResponseHeader) == 32, "Response header must be 32 bytes");
+
+constexpr char request_magic[4] = {'Z', '3', 'R', 'Q'}; /** Sygnatura zadania */
+constexpr char response_magic[4] = {'Z', '3', 'R', 'S'}; /** Sygnatura odpowiedzi */
+constexpr uint32_t request_length_limit = 1u << 30; /** Najwieksza dlugosc danych zadania */
+
+/**
+ * Serwer rozwiazujacy uklady przesylane ramkami przez deskryptory (stdin i stdout albo gniazdo Unix);
+ * watki puli trzymaja arene jako rozgrzana pamiec robocza, a rozklad LU macierzy zostaje w polaczeniu
+ * dla kolejnych zadan z flaga request_reuse
+ */
+class Server {
+public:
+    static constexpr size_t pending_limit = 256; /** Najwieksza liczba zadan polaczenia w toku */
+
+    /**
+     * Tworzy serwer z pula watkow
+     * @param threads liczba watkow (0 - tyle, ile rdzeni)
+     */
+    explicit Server(size_t threads = 0);
+
+    /**
+     * Obsluguje jedno polaczenie: czyta zadania do konca wejscia lub bledu ramki, a konczy po wyslaniu
+     * odpowiedzi na wszystkie przeczytane zadania
+     * @param input deskryptor zadan
+     * @param output deskryptor odpowiedzi
+     */
+    void serve(int input, int output);
+
+    /**
+     * Przyjmuje polaczenia na gniezdzie Unix, kazde obslugiwane osobnym watkiem; nie konczy sie
+     * @param path sciezka gniazda (istniejacy plik jest usuwany)
+     */
+    void listen(const std::string& path);
+
+private:
+    ThreadPool pool; /** Watki rozwiazujace zadania */
+};
+
+#endif //ZAD3_SERVER_HH
@@ -0,0 +1,668 @@
+#ifndef ZAD3_SIMDKERNELS_HH
+#define ZAD3_SIMDKERNELS_HH
+
+#include <cstddef>
+
+/* naglowek dolaczany takze przez jednostki kompilowane z flagami -mavx2 / -mavx512f,
+ * dlatego nie moze dolaczac zadnych innych naglowkow projektu ani biblioteki standardowej
+ * z funkcjami inline, ktore linker moglby potem wybrac dla calego programu */
+
+/**
+ * Tablica wskaznikow na jadra obliczeniowe jednego zestawu instrukcji
+ * @tparam T
+ */
+template <class T>
+struct KernelTable {
+    T (*dot)(const T* a, const T* b, size_t n); /** Iloczyn skalarny */
+    void (*axpy)(T alpha, const T* x, T* y, size_t n); /** y += alpha * x */
+    void (*scale)(T alpha, T* x, size_t n); /** x *= alpha */
+    void (*matvec)(const T* matrix, size_t stride, const T* x, T* y, size_t rows, size_t columns); /** y = Ax */
+    void (*gemm_subtract)(const T* a, size_t a_stride, const T* b, size_t b_stride, T* c, size_t c_stride,
+                          size_t rows, size_t columns, size_t depth); /** C -= AB */
+
+    /* jadra dla liczb zespolonych zapisanych w osobnych tablicach czesci rzeczywistych i urojonych */
+
+    void (*complex_dot)(const T* a_real, const T* a_imaginary, const T* b_real, const T* b_imaginary, size_t n,
+                        T& real, T& imaginary); /** Iloczyn skalarny (bez sprzezenia) */
+    void (*complex_axpy)(T alpha_real, T alpha_imaginary, const T* x_real, const T* x_imaginary,
+                         T* y_real, T* y_imaginary, size_t n); /** y += alpha * x */
+    void (*complex_multiply)(const T* a_real, const T* a_imaginary, const T* b_real, const T* b_imaginary,
+                             T* c_real, T* c_imaginary, size_t n); /** c = a * b po skladowych */
+    void (*complex_divide)(const T* a_real, const T* a_imaginary, const T* b_real, const T* b_imaginary,
+                           T* c_real, T* c_imaginary, size_t n); /** c = a / b po skladowych */
+    void (*complex_matvec)(const T* matrix_real, const T* matrix_imaginary, size_t stride,
+                           const T* x_real, const T* x_imaginary, T* y_real, T* y_imaginary,
+                           size_t rows, size_t columns); /** y = Ax */
+
+    /* jadra dla ukladow rownan zapisanych naprzemiennie: skalar (x, y) ukladu l lezy pod indeksem
+     * (x * (n + 1) + y) * lanes + l, kolumna n to wektor wyrazow wolnych, a wektory pod indeksem
+     * x * lanes + l; jadra rozwiazujace zwracaja maske bitowa ukladow osobliwych i, jesli pivots nie jest
+     * nullptr, zapisuja pod indeksem k * lanes + l modul k-tego elementu glownego ukladu l, a pod indeksem
+     * n * lanes + l liczbe jego wierszy poza swoja pozycja */
+
+    static constexpr size_t lanes = 64 / sizeof(T); /** Liczba ukladow rozwiazywanych naraz */
+
+    unsigned (*lane_solve)(const T* system, size_t n, T* solution, T* pivots); /** Ax = b */
+    unsigned (*complex_lane_solve)(const T* system_real, const T* system_imaginary, size_t n,
+                                   T* solution_real, T* solution_imaginary, T* pivots); /** Ax = b */
+    void (*lane_residual)(const T* system, size_t n, const T* solution, T* error); /** Blad Ax-b */
+    void (*complex_lane_residual)(const T* system_real, const T* system_imaginary, size_t n,
+                                  const T* solution_real, const T* solution_imaginary,
+                                  T* error_real, T* error_imaginary); /** Blad Ax-b */
+};
+
+/**
+ * Najwiekszy rozmiar ukladu obslugiwany przez jadra lane_solve, complex_lane_solve i ich lane_residual
+ */
+constexpr size_t lane_solver_limit = 8;
+
+/**
+ * Jadra obliczeniowe napisane raz dla dowolnego zestawu instrukcji opisanego przez Simd
+ * (typy scalar, vector i mask, szerokosc width oraz operacje zero, load, store, broadcast, add, sub, mul, div,
+ * fma (a * b + c), fnma (c - a * b), reduce, abs, greater (a > b), equal (a == b), select (m ? a : b),
+ * bits (maska jako liczba, bit i dla skladowej i))
+ * @tparam Simd
+ */
+template <class Simd>
+struct SimdKernels {
+    using T = typename Simd::scalar;
+    using V = typename Simd::vector;
+    using M = typename Simd::mask;
+    static constexpr size_t width = Simd::width;
+    static constexpr size_t lanes = KernelTable<T>::lanes;
+
+    /**
+     * Iloczyn skalarny na czterech niezaleznych akumulatorach, zeby nie czekac na wynik poprzedniego fma
+     */
+    static T dot(const T* a, const T* b, const size_t n) {
+        V s0 = Simd::zero(), s1 = Simd::zero(), s2 = Simd::zero(), s3 = Simd::zero();
+
+        size_t i = 0;
+        for (; i + 4 * width <= n; i += 4 * width) {
+            s0 = Simd::fma(Simd::load(a + i), Simd::load(b + i), s0);
+            s1 = Simd::fma(Simd::load(a + i + width), Simd::load(b + i + width), s1);
+            s2 = Simd::fma(Simd::load(a + i + 2 * width), Simd::load(b + i + 2 * width), s2);
+            s3 = Simd::fma(Simd::load(a + i + 3 * width), Simd::load(b + i + 3 * width), s3);
+        }
+        for (; i + width <= n; i += width)
+            s0 = Simd::fma(Simd::load(a + i), Simd::load(b + i), s0);
+
+        T result = Simd::reduce(Simd::add(Simd::add(s0, s1), Simd::add(s2, s3)));
+        for (; i < n; i++)
+            result += a[i] * b[i];
+        return result;
+    }
+
+    /**
+     * y += alpha * x
+     */
+    static void axpy(const T alpha, const T* x, T* y, const size_t n) {
+        const V a = Simd::broadcast(alpha);
+
+        size_t i = 0;
+        for (; i + 2 * width <= n; i += 2 * width) {
+            Simd::store(y + i, Simd::fma(a, Simd::load(x + i), Simd::load(y + i)));
+            Simd::store(y + i + width, Simd::fma(a, Simd::load(x + i + width), Simd::load(y + i + width)));
+        }
+        for (; i + width <= n; i += width)
+            Simd::store(y + i, Simd::fma(a, Simd::load(x + i), Simd::load(y + i)));
+        for (; i < n; i++)
+            y[i] += alpha * x[i];
+    }
+
+    /**
+     * x *= alpha
+     */
+    static void scale(const T alpha, T* x, const size_t n) {
+        const V a = Simd::broadcast(alpha);
+
+        size_t i = 0;
+        for (; i + width <= n; i += width)
+            Simd::store(x + i, Simd::mul(a, Simd::load(x + i)));
+        for (; i < n; i++)
+            x[i] *= alpha;
+    }
+
+    /**
+     * y = Ax dla macierzy zapisanej wierszami co stride skalarow; cztery wiersze naraz dziela odczyty x
+     */
+    static void matvec(const T* matrix, const size_t stride, const T* x, T* y, const size_t rows, const size_t columns) {
+        size_t r = 0;
+        for (; r + 4 <= rows; r += 4) {
+            const T* a0 = matrix + r * stride;
+            const T* a1 = a0 + stride;
+            const T* a2 = a1 + stride;
+            const T* a3 = a2 + stride;
+            V s0 = Simd::zero(), s1 = Simd::zero(), s2 = Simd::zero(), s3 = Simd::zero();
+
+            size_t c = 0;
+            for (; c + width <= columns; c += width) {
+                const V v = Simd::load(x + c);
+                s0 = Simd::fma(Simd::load(a0 + c), v, s0);
+                s1 = Simd::fma(Simd::load(a1 + c), v, s1);
+                s2 = Simd::fma(Simd::load(a2 + c), v, s2);
+                s3 = Simd::fma(Simd::load(a3 + c), v, s3);
+            }
+
+            T y0 = Simd::reduce(s0), y1 = Simd::reduce(s1), y2 = Simd::reduce(s2), y3 = Simd::reduce(s3);
+            for (; c < columns; c++) {
+                y0 += a0[c] * x[c];
+                y1 += a1[c] * x[c];
+                y2 += a2[c] * x[c];
+                y3 += a3[c] * x[c];
+            }
+            y[r] = y0;
+            y[r + 1] = y1;
+            y[r + 2] = y2;
+            y[r + 3] = y3;
+        }
+        for (; r < rows; r++)
+            y[r] = dot(matrix + r * stride, x, columns);
+    }
+
+    /**
+     * C -= AB dla macierzy zapisanych wierszami (A: rows x depth, B: depth x columns); bloki 4 wierszy
+     * na 2 rejestry kolumn C trzymane sa w rejestrach przez cala petle po depth, kazdy odczyt wiersza B
+     * sluzy czterem wierszom C
+     */
+    static void gemm_subtract(const T* a, const size_t a_stride, const T* b, const size_t b_stride,
+                              T* c, const size_t c_stride, const size_t rows, const size_t columns, const size_t depth) {
+        size_t i = 0;
+        for (; i + 4 <= rows; i += 4) {
+            const T* a0 = a + i * a_stride;
+            const T* a1 = a0 + a_stride;
+            const T* a2 = a1 + a_stride;
+            const T* a3 = a2 + a_stride;
+            T* c0 = c + i * c_stride;
+            T* c1 = c0 + c_stride;
+            T* c2 = c1 + c_stride;
+            T* c3 = c2 + c_stride;
+
+            size_t j = 0;
+            for (; j + 2 * width <= columns; j += 2 * width) {
+                V c00 = Simd::load(c0 + j), c01 = Simd::load(c0 + j + width);
+                V c10 = Simd::load(c1 + j), c11 = Simd::load(c1 + j + width);
+                V c20 = Simd::load(c2 + j), c21 = Simd::load(c2 + j + width);
+                V c30 = Simd::load(c3 + j), c31 = Simd::load(c3 + j + width);
+
+                for (size_t p = 0; p < depth; p++) {
+                    const T* row = b + p * b_stride + j;
+                    const V b0 = Simd::load(row), b1 = Simd::load(row + width);
+                    V x = Simd::broadcast(a0[p]);
+                    c00 = Simd::fnma(x, b0, c00);
+                    c01 = Simd::fnma(x, b1, c01);
+                    x = Simd::broadcast(a1[p]);
+                    c10 = Simd::fnma(x, b0, c10);
+                    c11 = Simd::fnma(x, b1, c11);
+                    x = Simd::broadcast(a2[p]);
+                    c20 = Simd::fnma(x, b0, c20);
+                    c21 = Simd::fnma(x, b1, c21);
+                    x = Simd::broadcast(a3[p]);
+                    c30 = Simd::fnma(x, b0, c30);
+                    c31 = Simd::fnma(x, b1, c31);
+                }
+
+                Simd::store(c0 + j, c00);
+                Simd::store(c0 + j + width, c01);
+                Simd::store(c1 + j, c10);
+                Simd::store(c1 + j + width, c11);
+                Simd::store(c2 + j, c20);
+                Simd::store(c2 + j + width, c21);
+                Simd::store(c3 + j, c30);
+                Simd::store(c3 + j + width, c31);
+            }
+
+            for (; j < columns; j++) {
+                T s0 = c0[j], s1 = c1[j], s2 = c2[j], s3 = c3[j];
+                for (size_t p = 0; p < depth; p++) {
+                    const T scalar = b[p * b_stride + j];
+                    s0 -= a0[p] * scalar;
+                    s1 -= a1[p] * scalar;
+                    s2 -= a2[p] * scalar;
+                    s3 -= a3[p] * scalar;
+                }
+                c0[j] = s0;
+                c1[j] = s1;
+                c2[j] = s2;
+                c3[j] = s3;
+            }
+        }
+
+        for (; i < rows; i++)
+            for (size_t p = 0; p < depth; p++)
+                axpy(-a[i * a_stride + p], b + p * b_stride, c + i * c_stride, columns);
+    }
+
+    /**
+     * Zespolony iloczyn skalarny, po dwa akumulatory na czesc rzeczywista i urojona
+     */
+    static void complex_dot(const T* ar, const T* ai, const T* br, const T* bi, const size_t n, T& real, T& imaginary) {
+        V r0 = Simd::zero(), r1 = Simd::zero(), i0 = Simd::zero(), i1 = Simd::zero();
+
+        size_t i = 0;
+        for (; i + 2 * width <= n; i += 2 * width) {
+            const V ar0 = Simd::load(ar + i), ai0 = Simd::load(ai + i), br0 = Simd::load(br + i), bi0 = Simd::load(bi + i);
+            const V ar1 = Simd::load(ar + i + width), ai1 = Simd::load(ai + i + width);
+            const V br1 = Simd::load(br + i + width), bi1 = Simd::load(bi + i + width);
+            r0 = Simd::fnma(ai0, bi0, Simd::fma(ar0, br0, r0));
+            i0 = Simd::fma(ai0, br0, Simd::fma(ar0, bi0, i0));
+            r1 = Simd::fnma(ai1, bi1, Simd::fma(ar1, br1, r1));
+            i1 = Simd::fma(ai1, br1, Simd::fma(ar1, bi1, i1));
+        }
+        for (; i + width <= n; i += width) {
+            const V ar0 = Simd::load(ar + i), ai0 = Simd::load(ai + i), br0 = Simd::load(br + i), bi0 = Simd::load(bi + i);
+            r0 = Simd::fnma(ai0, bi0, Simd::fma(ar0, br0, r0));
+            i0 = Simd::fma(ai0, br0, Simd::fma(ar0, bi0, i0));
+        }
+
+        real = Simd::reduce(Simd::add(r0, r1));
+        imaginary = Simd::reduce(Simd::add(i0, i1));
+        for (; i < n; i++) {
+            real += ar[i] * br[i] - ai[i] * bi[i];
+            imaginary += ar[i] * bi[i] + ai[i] * br[i];
+        }
+    }
+
+    /**
+     * y += alpha * x dla liczb zespolonych
+     */
+    static void complex_axpy(const T alpha_real, const T alpha_imaginary, const T* xr, const T* xi, T* yr, T* yi, const size_t n) {
+        const V a_r = Simd::broadcast(alpha_real);
+        const V a_i = Simd::broadcast(alpha_imaginary);
+
+        size_t i = 0;
+        for (; i + width <= n; i += width) {
+            const V x_r = Simd::load(xr + i), x_i = Simd::load(xi + i);
+            Simd::store(yr + i, Simd::fnma(a_i, x_i, Simd::fma(a_r, x_r, Simd::load(yr + i))));
+            Simd::store(yi + i, Simd::fma(a_i, x_r, Simd::fma(a_r, x_i, Simd::load(yi + i))));
+        }
+        for (; i < n; i++) {
+            const T x_r = xr[i], x_i = xi[i];
+            yr[i] += alpha_real * x_r - alpha_imaginary * x_i;
+            yi[i] += alpha_real * x_i + alpha_imaginary * x_r;
+        }
+    }
+
+    /**
+     * c = a * b po skladowych
+     */
+    static void complex_multiply(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, const size_t n) {
+        size_t i = 0;
+        for (; i + width <= n; i += width) {
+            const V a_r = Simd::load(ar + i), a_i = Simd::load(ai + i), b_r = Simd::load(br + i), b_i = Simd::load(bi + i);
+            Simd::store(cr + i, Simd::fnma(a_i, b_i, Simd::mul(a_r, b_r)));
+            Simd::store(ci + i, Simd::fma(a_i, b_r, Simd::mul(a_r, b_i)));
+        }
+        for (; i < n; i++) {
+            const T a_r = ar[i], a_i = ai[i], b_r = br[i], b_i = bi[i];
+            cr[i] = a_r * b_r - a_i * b_i;
+            ci[i] = a_r * b_i + a_i * b_r;
+        }
+    }
+
+    /**
+     * c = a / b po skladowych, mianownik to kwadrat modulu (bez pierwiastka)
+     */
+    static void complex_divide(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, const size_t n) {
+        size_t i = 0;
+        for (; i + width <= n; i += width) {
+            const V a_r = Simd::load(ar + i), a_i = Simd::load(ai + i), b_r = Simd::load(br + i), b_i = Simd::load(bi + i);
+            const V norm = Simd::fma(b_i, b_i, Simd::mul(b_r, b_r));
+            Simd::store(cr + i, Simd::div(Simd::fma(a_i, b_i, Simd::mul(a_r, b_r)), norm));
+            Simd::store(ci + i, Simd::div(Simd::fnma(a_r, b_i, Simd::mul(a_i, b_r)), norm));
+        }
+        for (; i < n; i++) {
+            const T a_r = ar[i], a_i = ai[i], b_r = br[i], b_i = bi[i];
+            const T norm = b_r * b_r + b_i * b_i;
+            cr[i] = (a_r * b_r + a_i * b_i) / norm;
+            ci[i] = (a_i * b_r - a_r * b_i) / norm;
+        }
+    }
+
+    /**
+     * y = Ax dla liczb zespolonych
+     */
+    static void complex_matvec(const T* matrix_real, const T* matrix_imaginary, const size_t stride,
+                               const T* xr, const T* xi, T* yr, T* yi, const size_t rows, const size_t columns) {
+        for (size_t r = 0; r < rows; r++)
+            complex_dot(matrix_real + r * stride, matrix_imaginary + r * stride, xr, xi, columns, yr[r], yi[r]);
+    }
+
+    /**
+     * Eliminacja Gaussa z czesciowym wyborem elementu glownego dla width ukladow o rozmiarze n naraz, po
+     * jednym na skladowa wektora; kazda skladowa wybiera wlasny wiersz glowny, a zamiana wierszy to wybor
+     * warunkowy, wiec wszystkie uklady wykonuja te same instrukcje. Rozmiar jest staly, zeby uklad byl
+     * tablica lokalna trzymana w rejestrach. Eliminacja i podstawianie wstecz nie uzywaja fma, tylko tych samych
+     * dzialan co FixedSolver, wiec rozwiazania i wykrycie macierzy osobliwej sa identyczne jak dla
+     * pojedynczego ukladu
+     * @tparam n
+     * @param system uklad zapisany naprzemiennie, przesuniety do pierwszego ukladu grupy
+     * @param solution
+     * @param pivots moduly elementow glownych i liczby przestawionych wierszy albo nullptr
+     * @return maska ukladow osobliwych grupy
+     */
+    template <size_t n>
+    static unsigned lane_group_solve(const T* system, T* solution, T* pivots) {
+        constexpr size_t stride = (n + 1) * lanes;
+        V a[n][n + 1];
+        for (size_t x = 0; x < n; x++)
+            for (size_t y = 0; y <= n; y++)
+                a[x][y] = Simd::load(system + x * stride + y * lanes);
+
+        V inverses[n], order[n];
+        for (size_t x = 0; x < n; x++)
+            order[x] = Simd::broadcast(T(x));
+        unsigned singular = 0;
+        for (size_t k = 0; k < n; k++) {
+            V magnitude = Simd::abs(a[k][k]);
+            V pivot = Simd::broadcast(T(k));
+            for (size_t x = k + 1; x < n; x++) {
+                const V candidate = Simd::abs(a[x][k]);
+                const M larger = Simd::greater(candidate, magnitude);
+                magnitude = Simd::select(larger, candidate, magnitude);
+                pivot = Simd::select(larger, Simd::broadcast(T(x)), pivot);
+            }
+            singular |= Simd::bits(Simd::equal(magnitude, Simd::zero()));
+            if (pivots)
+                swap_order<n>(k, pivot, magnitude, order, pivots);
+
+            for (size_t x = k + 1; x < n; x++) {
+                const M chosen = Simd::equal(pivot, Simd::broadcast(T(x)));
+                for (size_t y = k; y <= n; y++) {
+                    const V upper = a[k][y];
+                    a[k][y] = Simd::select(chosen, a[x][y], upper);
+                    a[x][y] = Simd::select(chosen, upper, a[x][y]);
+                }
+            }
+
+            inverses[k] = Simd::div(Simd::broadcast(T(1)), a[k][k]);
+            for (size_t x = k + 1; x < n; x++) {
+                const V factor = Simd::mul(a[x][k], inverses[k]);
+                for (size_t y = k + 1; y <= n; y++)
+                    a[x][y] = Simd::sub(a[x][y], Simd::mul(factor, a[k][y]));
+            }
+        }
+
+        V result[n];
+        for (size_t i = 0; i < n; i++) {
+            const size_t k = n - 1 - i;
+            V sum = a[k][n];
+            for (size_t y = k + 1; y < n; y++)
+                sum = Simd::sub(sum, Simd::mul(a[k][y], result[y]));
+            result[k] = Simd::mul(sum, inverses[k]);
+            Simd::store(solution + k * lanes, result[k]);
+        }
+        return singular;
+    }
+
+    /**
+     * Zapisuje modul k-tego elementu glownego grupy i przestawia numery wierszy jak zamiana wierszy k i pivot;
+     * po ostatnim kroku zapisuje liczbe wierszy poza swoja pozycja
+     * @tparam n
+     * @param k
+     * @param pivot numery wybranych wierszy
+     * @param magnitude moduly wybranych elementow
+     * @param order numery wierszy poczatkowego ukladu na kolejnych pozycjach
+     * @param pivots
+     */
+    template <size_t n>
+    static void swap_order(const size_t k, const V pivot, const V magnitude, V* order, T* pivots) {
+        Simd::store(pivots + k * lanes, magnitude);
+        for (size_t x = k + 1; x < n; x++) {
+            const M chosen = Simd::equal(pivot, Simd::broadcast(T(x)));
+            const V upper = order[k];
+            order[k] = Simd::select(chosen, order[x], upper);
+            order[x] = Simd::select(chosen, upper, order[x]);
+        }
+        if (k + 1 < n)
+            return;
+
+        V moved = Simd::zero();
+        for (size_t x = 0; x < n; x++)
+            moved = Simd::add(moved, Simd::select(Simd::equal(order[x], Simd::broadcast(T(x))), Simd::zero(), Simd::broadcast(T(1))));
+        Simd::store(pivots + n * lanes, moved);
+    }
+
+    /**
+     * Rozwiazuje lanes ukladow o rozmiarze n zapisanych naprzemiennie
+     * @tparam n
+     */
+    template <size_t n>
+    static unsigned lane_solve(const T* system, T* solution, T* pivots) {
+        unsigned singular = 0;
+        for (size_t l = 0; l < lanes; l += width)
+            singular |= lane_group_solve<n>(system + l, solution + l, pivots ? pivots + l : nullptr) << l;
+        return singular;
+    }
+
+    /**
+     * @see lane_solve, dla rozmiaru 1 <= n <= lane_solver_limit znanego w czasie wykonania
+     */
+    static unsigned lane_solve(const T* system, const size_t n, T* solution, T* pivots) {
+        switch (n) {
+            case 1:
+                return lane_solve<1>(system, solution, pivots);
+            case 2:
+                return lane_solve<2>(system, solution, pivots);
+            case 3:
+                return lane_solve<3>(system, solution, pivots);
+            case 4:
+                return lane_solve<4>(system, solution, pivots);
+            case 5:
+                return lane_solve<5>(system, solution, pivots);
+            case 6:
+                return lane_solve<6>(system, solution, pivots);
+            case 7:
+                return lane_solve<7>(system, solution, pivots);
+            default:
+                return lane_solve<8>(system, solution, pivots);
+        }
+    }
+
+    /**
+     * Wylicza wektory bledu Ax-b lanes ukladow o rozmiarze n zapisanych naprzemiennie; iloczyny sumowane
+     * sa po kolei bez fma, tak jak residual_fixed (FixedSolver.hh) liczy blad pojedynczego ukladu
+     * @param system
+     * @param n
+     * @param solution rozwiazania zapisane jak w lane_solve
+     * @param error
+     */
+    static void lane_residual(const T* system, const size_t n, const T* solution, T* error) {
+        const size_t stride = (n + 1) * lanes;
+        for (size_t l = 0; l < lanes; l += width) {
+            for (size_t x = 0; x < n; x++) {
+                V sum = Simd::zero();
+                for (size_t y = 0; y < n; y++)
+                    sum = Simd::add(sum, Simd::mul(Simd::load(system + x * stride + y * lanes + l), Simd::load(solution + y * lanes + l)));
+                Simd::store(error + x * lanes + l, Simd::sub(sum, Simd::load(system + x * stride + n * lanes + l)));
+            }
+        }
+    }
+
+    /**
+     * @see lane_group_solve, dla liczb zespolonych; element glowny wybierany wedlug |re| + |im| jak w Scalar
+     */
+    template <size_t n>
+    static unsigned complex_lane_group_solve(const T* system_real, const T* system_imaginary, T* solution_real, T* solution_imaginary,
+                                             T* pivots) {
+        constexpr size_t stride = (n + 1) * lanes;
+        V re[n][n + 1], im[n][n + 1];
+        for (size_t x = 0; x < n; x++) {
+            for (size_t y = 0; y <= n; y++) {
+                re[x][y] = Simd::load(system_real + x * stride + y * lanes);
+                im[x][y] = Simd::load(system_imaginary + x * stride + y * lanes);
+            }
+        }
+
+        V inverses_r[n], inverses_i[n], order[n];
+        for (size_t x = 0; x < n; x++)
+            order[x] = Simd::broadcast(T(x));
+        unsigned singular = 0;
+        for (size_t k = 0; k < n; k++) {
+            V magnitude = Simd::add(Simd::abs(re[k][k]), Simd::abs(im[k][k]));
+            V pivot = Simd::broadcast(T(k));
+            for (size_t x = k + 1; x < n; x++) {
+                const V candidate = Simd::add(Simd::abs(re[x][k]), Simd::abs(im[x][k]));
+                const M larger = Simd::greater(candidate, magnitude);
+                magnitude = Simd::select(larger, candidate, magnitude);
+                pivot = Simd::select(larger, Simd::broadcast(T(x)), pivot);
+            }
+            singular |= Simd::bits(Simd::equal(magnitude, Simd::zero()));
+            if (pivots)
+                swap_order<n>(k, pivot, magnitude, order, pivots);
+
+            for (size_t x = k + 1; x < n; x++) {
+                const M chosen = Simd::equal(pivot, Simd::broadcast(T(x)));
+                for (size_t y = k; y <= n; y++) {
+                    const V upper_r = re[k][y], upper_i = im[k][y];
+                    re[k][y] = Simd::select(chosen, re[x][y], upper_r);
+                    im[k][y] = Simd::select(chosen, im[x][y], upper_i);
+                    re[x][y] = Simd::select(chosen, upper_r, re[x][y]);
+                    im[x][y] = Simd::select(chosen, upper_i, im[x][y]);
+                }
+            }
+
+            /* 1 / p = sprzezenie p / |p|^2 */
+            const V norm = Simd::add(Simd::mul(re[k][k], re[k][k]), Simd::mul(im[k][k], im[k][k]));
+            inverses_r[k] = Simd::div(re[k][k], norm);
+            inverses_i[k] = Simd::div(Simd::sub(Simd::zero(), im[k][k]), norm);
+            for (size_t x = k + 1; x < n; x++) {
+                const V factor_r = Simd::sub(Simd::mul(re[x][k], inverses_r[k]), Simd::mul(im[x][k], inverses_i[k]));
+                const V factor_i = Simd::add(Simd::mul(re[x][k], inverses_i[k]), Simd::mul(im[x][k], inverses_r[k]));
+                for (size_t y = k + 1; y <= n; y++) {
+                    const V product_r = Simd::sub(Simd::mul(factor_r, re[k][y]), Simd::mul(factor_i, im[k][y]));
+                    const V product_i = Simd::add(Simd::mul(factor_r, im[k][y]), Simd::mul(factor_i, re[k][y]));
+                    re[x][y] = Simd::sub(re[x][y], product_r);
+                    im[x][y] = Simd::sub(im[x][y], product_i);
+                }
+            }
+        }
+
+        V result_r[n], result_i[n];
+        for (size_t i = 0; i < n; i++) {
+            const size_t k = n - 1 - i;
+            V sum_r = re[k][n], sum_i = im[k][n];
+            for (size_t y = k + 1; y < n; y++) {
+                sum_r = Simd::sub(sum_r, Simd::sub(Simd::mul(re[k][y], result_r[y]), Simd::mul(im[k][y], result_i[y])));
+                sum_i = Simd::sub(sum_i, Simd::add(Simd::mul(re[k][y], result_i[y]), Simd::mul(im[k][y], result_r[y])));
+            }
+            result_r[k] = Simd::sub(Simd::mul(sum_r, inverses_r[k]), Simd::mul(sum_i, inverses_i[k]));
+            result_i[k] = Simd::add(Simd::mul(sum_r, inverses_i[k]), Simd::mul(sum_i, inverses_r[k]));
+            Simd::store(solution_real + k * lanes, result_r[k]);
+            Simd::store(solution_imaginary + k * lanes, result_i[k]);
+        }
+        return singular;
+    }
+
+    /**
+     * @see lane_solve, dla liczb zespolonych zapisanych w osobnych tablicach czesci
+     * @tparam n
+     */
+    template <size_t n>
+    static unsigned complex_lane_solve(const T* system_real, const T* system_imaginary, T* solution_real, T* solution_imaginary,
+                                       T* pivots) {
+        unsigned singular = 0;
+        for (size_t l = 0; l < lanes; l += width)
+            singular |= complex_lane_group_solve<n>(system_real + l, system_imaginary + l, solution_real + l, solution_imaginary + l,
+                                                    pivots ? pivots + l : nullptr) << l;
+        return singular;
+    }
+
+    /**
+     * @see complex_lane_solve, dla rozmiaru 1 <= n <= lane_solver_limit znanego w czasie wykonania
+     */
+    static unsigned complex_lane_solve(const T* system_real, const T* system_imaginary, const size_t n,
+                                       T* solution_real, T* solution_imaginary, T* pivots) {
+        switch (n) {
+            case 1:
+                return complex_lane_solve<1>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+            case 2:
+                return complex_lane_solve<2>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+            case 3:
+                return complex_lane_solve<3>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+            case 4:
+                return complex_lane_solve<4>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+            case 5:
+                return complex_lane_solve<5>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+            case 6:
+                return complex_lane_solve<6>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+            case 7:
+                return complex_lane_solve<7>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+            default:
+                return complex_lane_solve<8>(system_real, system_imaginary, solution_real, solution_imaginary, pivots);
+        }
+    }
+
+    /**
+     * @see lane_residual, dla liczb zespolonych zapisanych w osobnych tablicach czesci; kolejnosc dzialan
+     * jak w residual_fixed dla liczb zespolonych
+     */
+    static void complex_lane_residual(const T* system_real, const T* system_imaginary, const size_t n,
+                                      const T* solution_real, const T* solution_imaginary, T* error_real, T* error_imaginary) {
+        const size_t stride = (n + 1) * lanes;
+        for (size_t l = 0; l < lanes; l += width) {
+            for (size_t x = 0; x < n; x++) {
+                const T* row_real = system_real + x * stride + l;
+                const T* row_imaginary = system_imaginary + x * stride + l;
+                /* iloczyny o parzystym i nieparzystym y w osobnych sumach, jak w ogolnym Kernels::dot */
+                V sum_r0 = Simd::zero(), sum_i0 = Simd::zero(), sum_r1 = Simd::zero(), sum_i1 = Simd::zero();
+                const auto accumulate = [&](const size_t y, V& sum_r, V& sum_i) {
+                    const V a_r = Simd::load(row_real + y * lanes), a_i = Simd::load(row_imaginary + y * lanes);
+                    const V x_r = Simd::load(solution_real + y * lanes + l), x_i = Simd::load(solution_imaginary + y * lanes + l);
+                    sum_r = Simd::add(sum_r, Simd::sub(Simd::mul(a_r, x_r), Simd::mul(a_i, x_i)));
+                    sum_i = Simd::add(sum_i, Simd::add(Simd::mul(a_r, x_i), Simd::mul(a_i, x_r)));
+                };
+                size_t y = 0;
+                for (; y + 2 <= n; y += 2) {
+                    accumulate(y, sum_r0, sum_i0);
+                    accumulate(y + 1, sum_r1, sum_i1);
+                }
+                if (y < n)
+                    accumulate(y, sum_r0, sum_i0);
+                Simd::store(error_real + x * lanes + l, Simd::sub(Simd::add(sum_r0, sum_r1), Simd::load(row_real + n * lanes)));
+                Simd::store(error_imaginary + x * lanes + l, Simd::sub(Simd::add(sum_i0, sum_i1), Simd::load(row_imaginary + n * lanes)));
+            }
+        }
+    }
+
+    /**
+     * Zwraca tablice jader
+     * @return tablica
+     */
+    static KernelTable<T> table() {
+        return KernelTable<T>{dot, axpy, scale, matvec, gemm_subtract,
+                              complex_dot, complex_axpy, complex_multiply, complex_divide, complex_matvec,
+                              lane_solve, complex_lane_solve, lane_residual, complex_lane_residual};
+    }
+};
+
+/**
+ * Opis "zestawu instrukcji" o szerokosci jednego skalara, uzywany gdy brak SIMD
+ * @tparam T
+ */
+template <class T>
+struct ScalarSimd {
+    using scalar = T;
+    using vector = T;
+    using mask = bool;
+    static constexpr size_t width = 1;
+
+    static vector zero() { return T(0); }
+    static vector load(const T* p) { return *p; }
+    static void store(T* p, vector v) { *p = v; }
+    static vector broadcast(T a) { return a; }
+    static vector add(vector a, vector b) { return a + b; }
+    static vector sub(vector a, vector b) { return a - b; }
+    static vector mul(vector a, vector b) { return a * b; }
+    static vector div(vector a, vector b) { return a / b; }
+    static vector fma(vector a, vector b, vector c) { return a * b + c; }
+    static vector fnma(vector a, vector b, vector c) { return c - a * b; }
+    static T reduce(vector v) { return v; }
+    static vector abs(vector a) { return a < 0 ? -a : a; }
+    static mask greater(vector a, vector b) { return a > b; }
+    static mask equal(vector a, vector b) { return a == b; }
+    static vector select(mask m, vector a, vector b) { return m ? a : b; }
+    static unsigned bits(mask m) { return m; }
+};
+
+#endif //ZAD3_SIMDKERNELS_HH
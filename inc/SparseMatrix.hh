@@ -0,0 +1,324 @@
+#ifndef ZAD3_SPARSEMATRIX_HH
+#define ZAD3_SPARSEMATRIX_HH
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../inc/Scalar.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/MatrixView.hh"
+
+/**
+ * Klasa reprezentujaca macierz rzadka o skalarach T w formacie CSR: niezerowe skalary zapisane wierszami,
+ * kolumny w wierszu rosnaco; pamiec i czas mnozenia proporcjonalne do liczby niezerowych skalarow
+ * @tparam T
+ */
+template <class T>
+class SparseMatrix {
+public:
+    using scalar_type = T; /** Typ skalara */
+
+    /**
+     * Tworzy macierz zerowa o podanym rozmiarze
+     * @param rows
+     * @param columns
+     */
+    SparseMatrix(size_t rows, size_t columns);
+
+    /**
+     * Tworzy macierz z gotowych tablic CSR, sprawdzajac ich spojnosc
+     * @param rows
+     * @param columns
+     * @param offsets poczatki wierszy (rows + 1 pozycji)
+     * @param indices kolumny niezerowych skalarow, w wierszu rosnaco
+     * @param values niezerowe skalary
+     */
+    SparseMatrix(size_t rows, size_t columns, std::vector<size_t> offsets, std::vector<size_t> indices, std::vector<T> values);
+
+    /**
+     * Tworzy macierz pusta
+     */
+    SparseMatrix() : SparseMatrix(0, 0) {}
+
+    /**
+     * Zwraca liczbe wierszy
+     * @return liczba wierszy
+     */
+    size_t rows() const;
+
+    /**
+     * Zwraca liczbe kolumn
+     * @return liczba kolumn
+     */
+    size_t columns() const;
+
+    /**
+     * Zwraca liczbe zapisanych skalarow
+     * @return liczba skalarow
+     */
+    size_t nonzeros() const;
+
+    /**
+     * Zwraca poczatki wierszy: skalary wiersza x to data()[row_offsets()[x]] .. data()[row_offsets()[x + 1] - 1]
+     * @return wskaznik
+     */
+    const size_t* row_offsets() const;
+
+    /**
+     * Zwraca kolumny zapisanych skalarow
+     * @return wskaznik
+     */
+    const size_t* column_indices() const;
+
+    /**
+     * Zwraca zapisane skalary
+     * @return wskaznik
+     */
+    const T* data() const;
+
+    /**
+     * Operator indeksowania ze sprawdzaniem granic, wyszukuje skalar w wierszu
+     * @param x
+     * @param y
+     * @return skalar (zero, jesli nie jest zapisany)
+     */
+    T operator()(size_t x, size_t y) const;
+
+    /**
+     * Mnozy macierz przez wektor
+     * @param vector
+     * @return wektor
+     */
+    DynamicVector<T> operator*(const DynamicVector<T>& vector) const;
+
+    /**
+     * Zwraca macierz transponowana (czyli te macierz w formacie CSC)
+     * @return macierz
+     */
+    SparseMatrix<T> transposed() const;
+
+private:
+    size_t rows_count; /** Liczba wierszy */
+    size_t columns_count; /** Liczba kolumn */
+    std::vector<size_t> offsets; /** Poczatki wierszy */
+    std::vector<size_t> indices; /** Kolumny skalarow */
+    std::vector<T> values; /** Skalary */
+};
+
+template <class T>
+SparseMatrix<T>::SparseMatrix(const size_t rows, const size_t columns)
+        : rows_count(rows), columns_count(columns), offsets(rows + 1, 0) {}
+
+template <class T>
+SparseMatrix<T>::SparseMatrix(const size_t rows, const size_t columns, std::vector<size_t> offsets,
+                              std::vector<size_t> indices, std::vector<T> values)
+        : rows_count(rows), columns_count(columns), offsets(std::move(offsets)), indices(std::move(indices)),
+          values(std::move(values)) {
+    if (this->offsets.size() != rows + 1 || this->offsets.front() != 0 || this->offsets.back() != this->values.size()
+        || this->indices.size() != this->values.size())
+        throw std::runtime_error("Size mismatch");
+
+    for (size_t x = 0; x < rows; x++) {
+        if (this->offsets[x] > this->offsets[x + 1])
+            throw std::runtime_error("Invalid sparse matrix");
+        for (size_t p = this->offsets[x]; p < this->offsets[x + 1]; p++)
+            if (this->indices[p] >= columns || (p > this->offsets[x] && this->indices[p] <= this->indices[p - 1]))
+                throw std::runtime_error("Invalid sparse matrix");
+    }
+}
+
+template <class T>
+size_t SparseMatrix<T>::rows() const {
+    return rows_count;
+}
+
+template <class T>
+size_t SparseMatrix<T>::columns() const {
+    return columns_count;
+}
+
+template <class T>
+size_t SparseMatrix<T>::nonzeros() const {
+    return values.size();
+}
+
+template <class T>
+const size_t* SparseMatrix<T>::row_offsets() const {
+    return offsets.data();
+}
+
+template <class T>
+const size_t* SparseMatrix<T>::column_indices() const {
+    return indices.data();
+}
+
+template <class T>
+const T* SparseMatrix<T>::data() const {
+    return values.data();
+}
+
+template <class T>
+T SparseMatrix<T>::operator()(const size_t x, const size_t y) const {
+    if (x >= rows_count || y >= columns_count)
+        throw std::runtime_error("Index out of range");
+
+    const auto first = indices.begin() + offsets[x], last = indices.begin() + offsets[x + 1];
+    const auto found = std::lower_bound(first, last, y);
+    return found != last && *found == y ? values[found - indices.begin()] : T();
+}
+
+template <class T>
+DynamicVector<T> SparseMatrix<T>::operator*(const DynamicVector<T>& vector) const {
+    if (vector.length() != columns_count)
+        throw std::runtime_error("Size mismatch");
+
+    DynamicVector<T> result(rows_count);
+    for (size_t x = 0; x < rows_count; x++) {
+        T sum = T();
+        for (size_t p = offsets[x]; p < offsets[x + 1]; p++)
+            sum += values[p] * vector[indices[p]];
+        result[x] = sum;
+    }
+    return result;
+}
+
+template <class T>
+SparseMatrix<T> SparseMatrix<T>::transposed() const {
+    /* sortowanie przez zliczanie po kolumnach; wiersze przegladane rosnaco, wiec kolumny wyniku tez sa rosnace */
+    std::vector<size_t> result_offsets(columns_count + 1, 0);
+    for (const size_t y : indices)
+        result_offsets[y + 1]++;
+    for (size_t y = 0; y < columns_count; y++)
+        result_offsets[y + 1] += result_offsets[y];
+
+    std::vector<size_t> result_indices(values.size());
+    std::vector<T> result_values(values.size());
+    std::vector<size_t> next(result_offsets.begin(), result_offsets.end() - 1);
+
+    for (size_t x = 0; x < rows_count; x++) {
+        for (size_t p = offsets[x]; p < offsets[x + 1]; p++) {
+            const size_t q = next[indices[p]]++;
+            result_indices[q] = x;
+            result_values[q] = values[p];
+        }
+    }
+
+    return SparseMatrix<T>(columns_count, rows_count, std::move(result_offsets), std::move(result_indices),
+                           std::move(result_values));
+}
+
+/**
+ * Specjalizacja cechy Resizable dla macierzy rzadkiej
+ * @tparam T
+ */
+template <class T>
+struct Resizable<SparseMatrix<T>> : std::true_type {};
+
+/**
+ * Budowa macierzy rzadkiej z trojek (wiersz, kolumna, skalar) w dowolnej kolejnosci (format COO);
+ * skalary o tych samych wspolrzednych sa sumowane, zera pomijane
+ * @tparam T
+ */
+template <class T>
+class SparseBuilder {
+public:
+    /**
+     * Tworzy budowe macierzy o podanym rozmiarze
+     * @param rows
+     * @param columns
+     */
+    SparseBuilder(size_t rows, size_t columns);
+
+    /**
+     * Dodaje skalar
+     * @param x
+     * @param y
+     * @param value
+     */
+    void add(size_t x, size_t y, const T& value);
+
+    /**
+     * Tworzy macierz CSR
+     * @return macierz
+     */
+    SparseMatrix<T> build() const;
+
+private:
+    /**
+     * Skalar wraz ze wspolrzednymi
+     */
+    struct Entry {
+        size_t x;
+        size_t y;
+        T value;
+    };
+
+    size_t rows; /** Liczba wierszy */
+    size_t columns; /** Liczba kolumn */
+    std::vector<Entry> entries; /** Dodane skalary */
+};
+
+template <class T>
+SparseBuilder<T>::SparseBuilder(const size_t rows, const size_t columns) : rows(rows), columns(columns) {}
+
+template <class T>
+void SparseBuilder<T>::add(const size_t x, const size_t y, const T& value) {
+    if (x >= rows || y >= columns)
+        throw std::runtime_error("Index out of range");
+    if (Scalar<T>::magnitude(value) != 0)
+        entries.push_back({x, y, value});
+}
+
+template <class T>
+SparseMatrix<T> SparseBuilder<T>::build() const {
+    /* rozdzielenie po wierszach przez zliczanie, potem sortowanie kolumn w obrebie wiersza */
+    std::vector<size_t> offsets(rows + 1, 0);
+    for (const Entry& entry : entries)
+        offsets[entry.x + 1]++;
+    for (size_t x = 0; x < rows; x++)
+        offsets[x + 1] += offsets[x];
+
+    std::vector<std::pair<size_t, T>> row_entries(entries.size());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (const Entry& entry : entries)
+        row_entries[next[entry.x]++] = {entry.y, entry.value};
+
+    std::vector<size_t> result_offsets(rows + 1, 0);
+    std::vector<size_t> indices;
+    std::vector<T> values;
+    indices.reserve(entries.size());
+    values.reserve(entries.size());
+
+    for (size_t x = 0; x < rows; x++) {
+        const auto first = row_entries.begin() + offsets[x], last = row_entries.begin() + offsets[x + 1];
+        std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (auto entry = first; entry != last; entry++) {
+            if (values.size() > result_offsets[x] && indices.back() == entry->first) {
+                values.back() += entry->second;
+            } else {
+                indices.push_back(entry->first);
+                values.push_back(entry->second);
+            }
+        }
+
+        /* sumy, ktore wyszly zerowe, nie sa zapisywane */
+        size_t kept = result_offsets[x];
+        for (size_t p = result_offsets[x]; p < values.size(); p++) {
+            if (Scalar<T>::magnitude(values[p]) != 0) {
+                indices[kept] = indices[p];
+                values[kept] = values[p];
+                kept++;
+            }
+        }
+        indices.resize(kept);
+        values.resize(kept);
+        result_offsets[x + 1] = kept;
+    }
+
+    return SparseMatrix<T>(rows, columns, std::move(result_offsets), std::move(indices), std::move(values));
+}
+
+#endif //ZAD3_SPARSEMATRIX_HH
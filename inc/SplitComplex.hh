@@ -0,0 +1,465 @@
+#ifndef ZAD3_SPLITCOMPLEX_HH
+#define ZAD3_SPLITCOMPLEX_HH
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Complex.hh"
+#include "../inc/Scalar.hh"
+#include "../inc/Kernels.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+
+/* liczby zespolone zapisane jako dwie osobne tablice (czesci rzeczywiste i urojone) zamiast tablicy
+ * par (re, im): kazda operacja zespolona to kilka operacji na ciaglych tablicach T, ktore jadra SIMD
+ * licza pelna szerokoscia rejestru, bez przestawiania czesci wewnatrz rejestru */
+
+/**
+ * Klasa reprezentujaca wektor liczb zespolonych Complex<T> o rozdzielonych czesciach
+ * @tparam T
+ */
+template <class T>
+class SplitComplexVector : public VectorExpression<SplitComplexVector<T>> {
+public:
+    using scalar_type = Complex<T>; /** Typ skalara */
+
+    DynamicVector<T> real; /** Czesci rzeczywiste */
+    DynamicVector<T> imaginary; /** Czesci urojone */
+
+    /**
+     * Tworzy wektor zerowy o podanej dlugosci
+     * @param length
+     */
+    explicit SplitComplexVector(size_t length);
+
+    /**
+     * Tworzy wektor pusty
+     */
+    SplitComplexVector() = default;
+
+    /**
+     * Tworzy wektor rozdzielajac czesci skalarow wektora lub wyrazenia o skalarach Complex<T>
+     * @param vector
+     */
+    template <class E>
+    explicit SplitComplexVector(const VectorExpression<E>& vector);
+
+    /**
+     * Zwraca dlugosc wektora
+     * @return dlugosc
+     */
+    size_t length() const;
+
+    /**
+     * Wylicza iloczyn skalarny
+     * @param vector
+     * @return wartosc
+     */
+    Complex<T> dot(const SplitComplexVector<T>& vector) const;
+
+    /**
+     * Mnozy wektory skalar po skalarze
+     * @param vector
+     * @return wektor iloczynow
+     */
+    SplitComplexVector<T> multiply(const SplitComplexVector<T>& vector) const;
+
+    /**
+     * Dzieli wektory skalar po skalarze
+     * @param vector
+     * @return wektor ilorazow
+     */
+    SplitComplexVector<T> divide(const SplitComplexVector<T>& vector) const;
+
+    /**
+     * Operator indeksowania wektora, sklada skalar z obu czesci
+     * @param i
+     * @return skalar na i-tej pozycji w wektorze
+     */
+    Complex<T> operator[](size_t i) const;
+
+    /**
+     * Operator indeksowania wektora ze sprawdzaniem granic
+     * @param i
+     * @return skalar na i-tej pozycji w wektorze
+     */
+    Complex<T> operator()(size_t i) const;
+
+    /**
+     * Zapisuje skalar na i-tej pozycji
+     * @param i
+     * @param scalar
+     */
+    void set(size_t i, const Complex<T>& scalar);
+
+    /**
+     * Wektor jest wyliczany tylko z wlasnych tablic
+     * @see ExpressionOperand::aliases
+     */
+    bool aliases(const void*) const;
+};
+
+template <class T>
+SplitComplexVector<T>::SplitComplexVector(const size_t length) : real(length), imaginary(length) {}
+
+template <class T>
+template <class E>
+SplitComplexVector<T>::SplitComplexVector(const VectorExpression<E>& vector)
+        : real(vector.derived().length()), imaginary(vector.derived().length()) {
+    const E& source = vector.derived();
+    for (size_t i = 0; i < length(); i++)
+        set(i, source[i]);
+}
+
+template <class T>
+size_t SplitComplexVector<T>::length() const {
+    return real.length();
+}
+
+template <class T>
+Complex<T> SplitComplexVector<T>::dot(const SplitComplexVector<T>& vector) const {
+    if (vector.length() != length())
+        throw std::runtime_error("Size mismatch");
+
+    Complex<T> result;
+    Kernels<T>::complex_dot(real.data(), imaginary.data(), vector.real.data(), vector.imaginary.data(), length(),
+                            result.real, result.imaginary);
+    return result;
+}
+
+template <class T>
+SplitComplexVector<T> SplitComplexVector<T>::multiply(const SplitComplexVector<T>& vector) const {
+    if (vector.length() != length())
+        throw std::runtime_error("Size mismatch");
+
+    SplitComplexVector<T> result(length());
+    Kernels<T>::complex_multiply(real.data(), imaginary.data(), vector.real.data(), vector.imaginary.data(),
+                                 result.real.data(), result.imaginary.data(), length());
+    return result;
+}
+
+template <class T>
+SplitComplexVector<T> SplitComplexVector<T>::divide(const SplitComplexVector<T>& vector) const {
+    if (vector.length() != length())
+        throw std::runtime_error("Size mismatch");
+
+    SplitComplexVector<T> result(length());
+    Kernels<T>::complex_divide(real.data(), imaginary.data(), vector.real.data(), vector.imaginary.data(),
+                               result.real.data(), result.imaginary.data(), length());
+    return result;
+}
+
+template <class T>
+Complex<T> SplitComplexVector<T>::operator[](const size_t i) const {
+    return Complex<T>(real[i], imaginary[i]);
+}
+
+template <class T>
+Complex<T> SplitComplexVector<T>::operator()(const size_t i) const {
+    if (i >= length())
+        throw std::runtime_error("Index out of range");
+    return (*this)[i];
+}
+
+template <class T>
+void SplitComplexVector<T>::set(const size_t i, const Complex<T>& scalar) {
+    real[i] = scalar.real;
+    imaginary[i] = scalar.imaginary;
+}
+
+template <class T>
+bool SplitComplexVector<T>::aliases(const void*) const {
+    return false;
+}
+
+/**
+ * Wektory sa argumentami wyrazen przechowywanymi przez referencje
+ * @tparam T
+ */
+template <class T>
+struct ExpressionOperand<SplitComplexVector<T>> {
+    using type = const SplitComplexVector<T>&;
+
+    static bool aliases(const SplitComplexVector<T>&, const void*) {
+        return false;
+    }
+};
+
+/**
+ * Klasa reprezentujaca macierz liczb zespolonych Complex<T> o rozdzielonych czesciach,
+ * obie czesci zapisane wierszami
+ * @tparam T
+ */
+template <class T>
+class SplitComplexMatrix {
+public:
+    using scalar_type = Complex<T>; /** Typ skalara */
+
+    DynamicMatrix<T> real; /** Czesci rzeczywiste */
+    DynamicMatrix<T> imaginary; /** Czesci urojone */
+
+    /**
+     * Tworzy macierz zerowa o podanych wymiarach
+     * @param rows
+     * @param columns
+     */
+    SplitComplexMatrix(size_t rows, size_t columns);
+
+    /**
+     * Tworzy macierz pusta
+     */
+    SplitComplexMatrix() = default;
+
+    /**
+     * Tworzy macierz rozdzielajac czesci skalarow macierzy o skalarach Complex<T>
+     * (Matrix, DynamicMatrix lub widoku, wymaga rows(), columns() i matrix[x][y])
+     * @param matrix
+     */
+    template <class M>
+    explicit SplitComplexMatrix(const M& matrix);
+
+    /**
+     * Zwraca liczbe wierszy
+     * @return liczba wierszy
+     */
+    size_t rows() const;
+
+    /**
+     * Zwraca liczbe kolumn
+     * @return liczba kolumn
+     */
+    size_t columns() const;
+
+    /**
+     * Operator mnozenia macierzy przez wektor
+     * @param vector
+     * @return wektor wyniku
+     */
+    SplitComplexVector<T> operator*(const SplitComplexVector<T>& vector) const;
+
+    /**
+     * Operator indeksowania macierzy ze sprawdzaniem granic, sklada skalar z obu czesci
+     * @param x
+     * @param y
+     * @return skalar na (x, y)-tej pozycji w macierzy
+     */
+    Complex<T> operator()(size_t x, size_t y) const;
+
+    /**
+     * Zapisuje skalar na (x, y)-tej pozycji
+     * @param x
+     * @param y
+     * @param scalar
+     */
+    void set(size_t x, size_t y, const Complex<T>& scalar);
+};
+
+template <class T>
+SplitComplexMatrix<T>::SplitComplexMatrix(const size_t rows, const size_t columns)
+        : real(rows, columns), imaginary(rows, columns) {}
+
+template <class T>
+template <class M>
+SplitComplexMatrix<T>::SplitComplexMatrix(const M& matrix) : SplitComplexMatrix(matrix.rows(), matrix.columns()) {
+    for (size_t x = 0; x < rows(); x++) {
+        const auto row = matrix[x];
+        for (size_t y = 0; y < columns(); y++)
+            set(x, y, row[y]);
+    }
+}
+
+template <class T>
+size_t SplitComplexMatrix<T>::rows() const {
+    return real.rows();
+}
+
+template <class T>
+size_t SplitComplexMatrix<T>::columns() const {
+    return real.columns();
+}
+
+template <class T>
+SplitComplexVector<T> SplitComplexMatrix<T>::operator*(const SplitComplexVector<T>& vector) const {
+    if (vector.length() != columns())
+        throw std::runtime_error("Size mismatch");
+
+    SplitComplexVector<T> result(rows());
+    Kernels<T>::complex_matvec(real.data(), imaginary.data(), columns(), vector.real.data(), vector.imaginary.data(),
+                               result.real.data(), result.imaginary.data(), rows(), columns());
+    return result;
+}
+
+template <class T>
+Complex<T> SplitComplexMatrix<T>::operator()(const size_t x, const size_t y) const {
+    return Complex<T>(real(x, y), imaginary(x, y));
+}
+
+template <class T>
+void SplitComplexMatrix<T>::set(const size_t x, const size_t y, const Complex<T>& scalar) {
+    real[x][y] = scalar.real;
+    imaginary[x][y] = scalar.imaginary;
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, const SplitComplexMatrix<T>& matrix) {
+    for (size_t x = 0; x < matrix.rows(); x++) {
+        for (size_t y = 0; y < matrix.columns(); y++) {
+            out << matrix(x, y);
+            if (y < matrix.columns() - 1)
+                out << " ";
+        }
+        if (x < matrix.rows() - 1)
+            out << "\n";
+    }
+    return out;
+}
+
+/**
+ * Klasa reprezentujaca rozklad LU macierzy zespolonej o rozdzielonych czesciach (PA = LU);
+ * aktualizacje wierszy i podstawienia to zespolone jadra axpy i iloczynu skalarnego
+ * @tparam T
+ */
+template <class T>
+class SplitComplexLUDecomposition {
+public:
+    /**
+     * Rozklada podana macierz
+     * @param matrix
+     */
+    explicit SplitComplexLUDecomposition(const SplitComplexMatrix<T>& matrix);
+
+    /**
+     * Zwraca rozmiar rozlozonej macierzy
+     * @return rozmiar
+     */
+    size_t size() const;
+
+    /**
+     * Wylicza wyznacznik rozlozonej macierzy
+     * @return wartosc
+     */
+    Complex<T> det() const;
+
+    /**
+     * Rozwiazuje uklad Ax = b dla rozlozonej macierzy A
+     * @param vector wektor b
+     * @return wektor x
+     */
+    SplitComplexVector<T> solve(const SplitComplexVector<T>& vector) const;
+
+private:
+    SplitComplexMatrix<T> factors; /** Macierze L i U zapisane razem */
+    std::vector<size_t> permutation; /** Permutacja wierszy */
+    bool odd = false; /** Nieparzystosc permutacji */
+
+    /**
+     * Rozklada macierz czynnikow w miejscu
+     */
+    void decompose();
+};
+
+template <class T>
+SplitComplexLUDecomposition<T>::SplitComplexLUDecomposition(const SplitComplexMatrix<T>& matrix)
+        : factors(matrix), permutation(matrix.rows()) {
+    if (matrix.rows() != matrix.columns())
+        throw std::runtime_error("Matrix is not square");
+    decompose();
+}
+
+template <class T>
+void SplitComplexLUDecomposition<T>::decompose() {
+    DynamicMatrix<T>& real = factors.real;
+    DynamicMatrix<T>& imaginary = factors.imaginary;
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; i++)
+        permutation[i] = i;
+
+    for (size_t k = 0; k < n; k++) {
+        size_t pivot = k;
+        T pivot_magnitude = Scalar<T>::magnitude(real[k][k]) + Scalar<T>::magnitude(imaginary[k][k]);
+        for (size_t x = k + 1; x < n; x++) {
+            const T magnitude = Scalar<T>::magnitude(real[x][k]) + Scalar<T>::magnitude(imaginary[x][k]);
+            if (magnitude > pivot_magnitude) {
+                pivot = x;
+                pivot_magnitude = magnitude;
+            }
+        }
+
+        if (pivot_magnitude == T(0))
+            throw std::runtime_error("Singular matrix");
+
+        if (pivot != k) {
+            std::swap_ranges(real[k], real[k] + n, real[pivot]);
+            std::swap_ranges(imaginary[k], imaginary[k] + n, imaginary[pivot]);
+            std::swap(permutation[k], permutation[pivot]);
+            odd = !odd;
+        }
+
+        const Complex<T> diagonal(real[k][k], imaginary[k][k]);
+        for (size_t x = k + 1; x < n; x++) {
+            const Complex<T> factor = Complex<T>(real[x][k], imaginary[x][k]) / diagonal;
+            real[x][k] = factor.real;
+            imaginary[x][k] = factor.imaginary;
+
+            Kernels<T>::complex_axpy(-factor.real, -factor.imaginary, real[k] + k + 1, imaginary[k] + k + 1,
+                                     real[x] + k + 1, imaginary[x] + k + 1, n - k - 1);
+        }
+    }
+}
+
+template <class T>
+size_t SplitComplexLUDecomposition<T>::size() const {
+    return permutation.size();
+}
+
+template <class T>
+Complex<T> SplitComplexLUDecomposition<T>::det() const {
+    Complex<T> result(1);
+    for (size_t i = 0; i < size(); i++)
+        result = result * factors(i, i);
+    return odd ? Complex<T>() - result : result;
+}
+
+template <class T>
+SplitComplexVector<T> SplitComplexLUDecomposition<T>::solve(const SplitComplexVector<T>& vector) const {
+    if (vector.length() != size())
+        throw std::runtime_error("Size mismatch");
+
+    const DynamicMatrix<T>& real = factors.real;
+    const DynamicMatrix<T>& imaginary = factors.imaginary;
+    const size_t n = size();
+
+    SplitComplexVector<T> result(n);
+    T* result_real = result.real.data();
+    T* result_imaginary = result.imaginary.data();
+    for (size_t i = 0; i < n; i++) {
+        result_real[i] = vector.real[permutation[i]];
+        result_imaginary[i] = vector.imaginary[permutation[i]];
+    }
+
+    /* Ly = Pb, L ma jedynki na przekatnej */
+    for (size_t x = 1; x < n; x++) {
+        T sum_real, sum_imaginary;
+        Kernels<T>::complex_dot(real[x], imaginary[x], result_real, result_imaginary, x, sum_real, sum_imaginary);
+        result_real[x] -= sum_real;
+        result_imaginary[x] -= sum_imaginary;
+    }
+
+    /* Ux = y */
+    for (size_t x = n; x-- > 0;) {
+        T sum_real, sum_imaginary;
+        Kernels<T>::complex_dot(real[x] + x + 1, imaginary[x] + x + 1, result_real + x + 1, result_imaginary + x + 1,
+                                n - x - 1, sum_real, sum_imaginary);
+        result.set(x, Complex<T>(result_real[x] - sum_real, result_imaginary[x] - sum_imaginary) / factors(x, x));
+    }
+
+    return result;
+}
+
+using SplitComplexVectord = SplitComplexVector<double>; /** Alias dla wektora liczb zespolonych */
+using SplitComplexMatrixd = SplitComplexMatrix<double>; /** Alias dla macierzy liczb zespolonych */
+
+#endif //ZAD3_SPLITCOMPLEX_HH
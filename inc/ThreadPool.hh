@@ -0,0 +1,155 @@
+#ifndef ZAD3_THREADPOOL_HH
+#define ZAD3_THREADPOOL_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../inc/AlignedAllocator.hh"
+
+/**
+ * Grupa zadan, na ktorych zakonczenie mozna czekac; pierwszy wyjatek rzucony przez zadanie
+ * grupy jest rzucany ponownie z ThreadPool::wait
+ */
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+private:
+    friend class ThreadPool;
+
+    std::atomic<size_t> pending{0}; /** Liczba niezakonczonych zadan */
+    std::mutex mutex; /** Chroni wyjatek */
+    std::exception_ptr exception; /** Pierwszy wyjatek rzucony przez zadanie */
+};
+
+/**
+ * Pula watkow z podkradaniem zadan: kazdy watek ma wlasna kolejke, zadania zlecone z watku puli
+ * trafiaja do jego kolejki (LIFO, dane jeszcze w cache), a bezczynny watek podkrada najstarsze
+ * zadania z kolejek pozostalych
+ */
+class ThreadPool {
+public:
+    /**
+     * Tworzy pule z podana liczba watkow (0 - tyle, ile rdzeni)
+     * @param workers
+     */
+    explicit ThreadPool(size_t workers = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Konczy prace watkow po wykonaniu wszystkich zleconych zadan
+     */
+    ~ThreadPool();
+
+    /**
+     * Zwraca liczbe watkow
+     * @return liczba watkow
+     */
+    size_t size() const;
+
+    /**
+     * Zleca zadanie w ramach grupy
+     * @param group
+     * @param task
+     */
+    void run(TaskGroup& group, std::function<void()> task);
+
+    /**
+     * Czeka na zakonczenie wszystkich zadan grupy, w miedzyczasie wykonujac zadania z kolejek
+     * (mozna wiec czekac takze z wnetrza zadania); rzuca ponownie pierwszy wyjatek z zadan grupy
+     * @param group
+     */
+    void wait(TaskGroup& group);
+
+    /**
+     * Wykonuje body(begin, end) dla rozlacznych przedzialow pokrywajacych [0, count) i czeka na wynik;
+     * przedzialy dziedzicza zasob pamieci (AllocationScope) watku wywolujacego
+     * @param count
+     * @param grain dlugosc przedzialu (0 - dobrana tak, by kazdy watek dostal kilka przedzialow)
+     * @param body
+     */
+    template <class F>
+    void parallel_for(size_t count, size_t grain, F body);
+
+private:
+    /**
+     * Zadanie wraz z grupa, do ktorej nalezy
+     */
+    struct Task {
+        std::function<void()> function;
+        TaskGroup* group;
+    };
+
+    /**
+     * Kolejka zadan jednego watku
+     */
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues; /** Kolejki, po jednej na watek */
+    std::vector<std::thread> threads; /** Watki puli */
+
+    std::atomic<size_t> queued{0}; /** Liczba zadan czekajacych w kolejkach */
+    std::atomic<size_t> next_queue{0}; /** Kolejka dla zadan zlecanych spoza puli */
+    bool stopping = false; /** Czy pula konczy prace */
+
+    std::mutex sleep_mutex; /** Chroni usypianie i budzenie watkow */
+    std::condition_variable wake; /** Budzi watki przy nowych zadaniach */
+    std::condition_variable finished; /** Budzi czekajacych przy zakonczeniu grupy */
+
+    /**
+     * Petla watku puli
+     * @param index
+     */
+    void work(size_t index);
+
+    /**
+     * Pobiera i wykonuje jedno zadanie: najpierw najnowsze z wlasnej kolejki, potem najstarsze z cudzych
+     * @param index kolejka, od ktorej zaczac
+     * @return false jesli wszystkie kolejki byly puste
+     */
+    bool run_one(size_t index);
+
+    /**
+     * Zwraca indeks watku puli wywolujacego metode lub size() dla watkow spoza puli
+     * @return indeks
+     */
+    size_t current() const;
+};
+
+template <class F>
+void ThreadPool::parallel_for(const size_t count, size_t grain, F body) {
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = count / (4 * size()) + 1;
+
+    /* przedzialy alokuja z zasobu pamieci watku wywolujacego (np. jego areny), a nie ze sterty */
+    std::pmr::memory_resource* const resource = scoped_resource();
+
+    TaskGroup group;
+    for (size_t begin = 0; begin < count; begin += grain) {
+        const size_t end = begin + grain < count ? begin + grain : count;
+        run(group, [&body, resource, begin, end] {
+            const AllocationScope scope(resource);
+            body(begin, end);
+        });
+    }
+    wait(group);
+}
+
+#endif //ZAD3_THREADPOOL_HH
@@ -0,0 +1,269 @@
+#ifndef ZAD3_UPDATEDLUDECOMPOSITION_HH
+#define ZAD3_UPDATEDLUDECOMPOSITION_HH
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../inc/Scalar.hh"
+#include "../inc/Kernels.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/LUDecomposition.hh"
+
+/**
+ * Rozklad LU macierzy zmienianej poprawkami rzedu 1 (A += uv^T): rozklad nie jest liczony od nowa,
+ * tylko kazda poprawka zapamietuje z = A^-1 u sprzed poprawki i mianownik 1 + v^T z, a solve stosuje
+ * wzor Shermana-Morrisona kolejno dla wszystkich poprawek; poprawka i rozwiazanie kosztuja
+ * O(n^2 + kn) zamiast O(n^3), gdzie k - liczba poprawek od ostatniego rozkladu. Po refactor_interval
+ * poprawkach macierz jest rozkladana od nowa, zeby ograniczyc narastanie bledow zaokraglen
+ * @tparam T
+ */
+template <class T>
+class UpdatedLUDecomposition {
+public:
+    static constexpr size_t default_refactor_interval = 32; /** Domyslna liczba poprawek miedzy rozkladami */
+
+    /**
+     * Rozklada macierz kwadratowa
+     * @param matrix
+     * @param refactor_interval liczba poprawek, po ktorej macierz jest rozkladana od nowa (0 - zawsze)
+     */
+    explicit UpdatedLUDecomposition(const DynamicMatrix<T>& matrix, size_t refactor_interval = default_refactor_interval);
+
+    /**
+     * Zwraca rozmiar macierzy
+     * @return rozmiar
+     */
+    size_t size() const;
+
+    /**
+     * Zwraca macierz po wszystkich poprawkach
+     * @return macierz
+     */
+    const DynamicMatrix<T>& matrix() const;
+
+    /**
+     * Zwraca liczbe poprawek od ostatniego rozkladu
+     * @return liczba poprawek
+     */
+    size_t updates() const;
+
+    /**
+     * Poprawia macierz A += uv^T
+     * @param u
+     * @param v
+     */
+    void update(const DynamicVector<T>& u, const DynamicVector<T>& v);
+
+    /**
+     * Poprawia macierz A += UV^T (wzor Woodbury'ego) jako k kolejnych poprawek rzedu 1
+     * @param u macierz n x k
+     * @param v macierz n x k
+     */
+    void update(const DynamicMatrix<T>& u, const DynamicMatrix<T>& v);
+
+    /**
+     * Zastepuje kolumne macierzy, O(n^2)
+     * @param y
+     * @param column
+     */
+    void replace_column(size_t y, const DynamicVector<T>& column);
+
+    /**
+     * Zastepuje wiersz macierzy, O(n^2)
+     * @param x
+     * @param row
+     */
+    void replace_row(size_t x, const DynamicVector<T>& row);
+
+    /**
+     * Zastepuje jeden skalar macierzy, O(n^2)
+     * @param x
+     * @param y
+     * @param value
+     */
+    void replace(size_t x, size_t y, const T& value);
+
+    /**
+     * Rozklada macierz po poprawkach od nowa i usuwa zapamietane poprawki
+     */
+    void refactor();
+
+    /**
+     * Oblicza wyznacznik z lematu o wyznaczniku: det(A + uv^T) = det(A) (1 + v^T A^-1 u)
+     * @return wyznacznik
+     */
+    T det() const;
+
+    /**
+     * Rozwiazuje uklad z macierza po poprawkach
+     * @param vector
+     * @return wektor
+     */
+    DynamicVector<T> solve(const DynamicVector<T>& vector) const;
+
+private:
+    DynamicMatrix<T> current; /** Macierz po poprawkach */
+    DynamicLUDecomposition<T> decomposition; /** Rozklad macierzy z ostatniego rozkladu */
+    size_t interval; /** Liczba poprawek miedzy rozkladami */
+
+    /* dla poprawki i: z_i = A_(i-1)^-1 u_i, v_i i mianownik 1 + v_i^T z_i */
+
+    std::vector<DynamicVector<T>> corrections; /** Wektory z */
+    std::vector<DynamicVector<T>> directions; /** Wektory v */
+    std::vector<T> denominators; /** Mianowniki */
+
+    /**
+     * Zapamietuje poprawke uv^T juz dodana do current lub rozklada macierz od nowa; gdy macierz po
+     * poprawce jest osobliwa, cofa poprawke i rzuca wyjatek
+     * @param u
+     * @param v
+     */
+    void append(const DynamicVector<T>& u, const DynamicVector<T>& v);
+};
+
+template <class T>
+UpdatedLUDecomposition<T>::UpdatedLUDecomposition(const DynamicMatrix<T>& matrix, const size_t refactor_interval)
+        : current(matrix), decomposition(matrix), interval(refactor_interval) {}
+
+template <class T>
+size_t UpdatedLUDecomposition<T>::size() const {
+    return current.rows();
+}
+
+template <class T>
+const DynamicMatrix<T>& UpdatedLUDecomposition<T>::matrix() const {
+    return current;
+}
+
+template <class T>
+size_t UpdatedLUDecomposition<T>::updates() const {
+    return corrections.size();
+}
+
+template <class T>
+void UpdatedLUDecomposition<T>::update(const DynamicVector<T>& u, const DynamicVector<T>& v) {
+    if (u.length() != size() || v.length() != size())
+        throw std::runtime_error("Size mismatch");
+
+    for (size_t x = 0; x < size(); x++)
+        Kernels<T>::axpy(u[x], v.data(), current[x], size());
+    append(u, v);
+}
+
+template <class T>
+void UpdatedLUDecomposition<T>::update(const DynamicMatrix<T>& u, const DynamicMatrix<T>& v) {
+    if (u.rows() != size() || v.rows() != size() || u.columns() != v.columns())
+        throw std::runtime_error("Size mismatch");
+
+    DynamicVector<T> u_column(size()), v_column(size());
+    for (size_t k = 0; k < u.columns(); k++) {
+        for (size_t i = 0; i < size(); i++) {
+            u_column[i] = u[i][k];
+            v_column[i] = v[i][k];
+        }
+        update(u_column, v_column);
+    }
+}
+
+template <class T>
+void UpdatedLUDecomposition<T>::replace_column(const size_t y, const DynamicVector<T>& column) {
+    if (y >= size())
+        throw std::runtime_error("Index out of range");
+    if (column.length() != size())
+        throw std::runtime_error("Size mismatch");
+
+    DynamicVector<T> u(size()), v(size());
+    for (size_t x = 0; x < size(); x++) {
+        u[x] = column[x] - current[x][y];
+        current[x][y] = column[x];
+    }
+    v[y] = T(1);
+    append(u, v);
+}
+
+template <class T>
+void UpdatedLUDecomposition<T>::replace_row(const size_t x, const DynamicVector<T>& row) {
+    if (x >= size())
+        throw std::runtime_error("Index out of range");
+    if (row.length() != size())
+        throw std::runtime_error("Size mismatch");
+
+    DynamicVector<T> u(size()), v(size());
+    for (size_t y = 0; y < size(); y++) {
+        v[y] = row[y] - current[x][y];
+        current[x][y] = row[y];
+    }
+    u[x] = T(1);
+    append(u, v);
+}
+
+template <class T>
+void UpdatedLUDecomposition<T>::replace(const size_t x, const size_t y, const T& value) {
+    if (x >= size() || y >= size())
+        throw std::runtime_error("Index out of range");
+
+    DynamicVector<T> u(size()), v(size());
+    u[x] = value - current[x][y];
+    v[y] = T(1);
+    current[x][y] = value;
+    append(u, v);
+}
+
+template <class T>
+void UpdatedLUDecomposition<T>::append(const DynamicVector<T>& u, const DynamicVector<T>& v) {
+    using R = typename Scalar<T>::real_type;
+
+    /* maly mianownik to macierz (prawie) osobliwa po poprawce i wzor wzmacnialby bledy, wiec wtedy,
+     * podobnie jak po refactor_interval poprawkach, macierz jest rozkladana od nowa */
+    if (corrections.size() < interval) {
+        DynamicVector<T> z = solve(u);
+        const T denominator = T(1) + v.dot(z);
+
+        if (Scalar<T>::magnitude(denominator) > std::sqrt(std::numeric_limits<R>::epsilon())) {
+            corrections.push_back(std::move(z));
+            directions.push_back(v);
+            denominators.push_back(denominator);
+            return;
+        }
+    }
+
+    /* macierz osobliwa: poprawka jest cofana, a wyjatek przekazywany dalej */
+    try {
+        refactor();
+    } catch (const std::runtime_error&) {
+        for (size_t x = 0; x < size(); x++)
+            Kernels<T>::axpy(T(0) - u[x], v.data(), current[x], size());
+        throw;
+    }
+}
+
+template <class T>
+void UpdatedLUDecomposition<T>::refactor() {
+    decomposition = DynamicLUDecomposition<T>(current);
+    corrections.clear();
+    directions.clear();
+    denominators.clear();
+}
+
+template <class T>
+T UpdatedLUDecomposition<T>::det() const {
+    T result = decomposition.det();
+    for (const T& denominator : denominators)
+        result = result * denominator;
+    return result;
+}
+
+template <class T>
+DynamicVector<T> UpdatedLUDecomposition<T>::solve(const DynamicVector<T>& vector) const {
+    /* (A + uv^T)^-1 b = A^-1 b - z (v^T A^-1 b) / (1 + v^T z) */
+    DynamicVector<T> result = decomposition.solve(vector);
+    for (size_t i = 0; i < corrections.size(); i++)
+        Kernels<T>::axpy(T(0) - directions[i].dot(result) / denominators[i], corrections[i].data(), result.data(), size());
+    return result;
+}
+
+#endif //ZAD3_UPDATEDLUDECOMPOSITION_HH
@@ -5,6 +5,7 @@
 #include <cmath>
 
 #include "../inc/Complex.hh"
+#include "../inc/VectorExpression.hh"
 
 /**
  * Klasa reprezentujaca wektor o skalarach T i rozmiarze size
@@ -12,68 +13,79 @@
  * @tparam size
  */
 template <class T, size_t size>
-class Vector {
+class Vector : public VectorExpression<Vector<T, size>> {
 
 public:
+    using scalar_type = T; /** Typ skalara */
+
     /**
      * Tworzy wektor o wszystkich skalarach rownych podanemu
      * @param scalar
      */
-    explicit Vector(T scalar);
+    constexpr explicit Vector(T scalar);
 
     /**
      * Tworzy wektor zerowy
      */
-    Vector() = default;
+    constexpr Vector() = default;
 
     /**
-     * Wylicza iloczyn skalarny
-     * @param vector
-     * @return wartosc
+     * Tworzy wektor wyliczajac wyrazenie wektorowe
+     * @param expression
      */
-    T dot(const Vector<T, size>& vector) const;
+    template <class E>
+    constexpr Vector(const VectorExpression<E>& expression);
 
     /**
-     * Operator dodawania wektorow
-     * @param vector
-     * @return wektor
+     * Operator przypisania wyrazenia wektorowego, jedyne miejsce zapisu skalarow wyrazenia
+     * @param expression
+     * @return referencja na wektor
      */
-    Vector<T, size> operator+(const Vector<T, size>& vector) const;
+    template <class E>
+    constexpr Vector<T, size>& operator=(const VectorExpression<E>& expression);
 
     /**
-     * Operator odejmowania wektorow
-     * @param vector
-     * @return wektor
+     * Zwraca dlugosc wektora
+     * @return dlugosc
      */
-    Vector<T, size> operator-(const Vector<T, size>& vector) const;
+    static constexpr size_t length();
 
     /**
-     * Operator mnozenia wektora przez skalar
-     * @param scalar
-     * @return wektor
+     * Zwraca wskaznik na poczatek danych
+     * @return wskaznik
      */
-    Vector<T, size> operator*(T scalar) const;
+    constexpr const T* data() const;
 
     /**
-     * Operator dzielenia wektora przez skalar
-     * @param scalar
-     * @return wektor
+     * Zwraca wskaznik na poczatek danych
+     * @return wskaznik
+     */
+    constexpr T* data();
+
+    /* operatory arytmetyczne (+, -, *, /) tworza wyrazenia wektorowe z VectorExpression.hh */
+
+    /**
+     * Wylicza iloczyn skalarny
+     * @param vector
+     * @return wartosc
      */
-    Vector<T, size> operator/(T scalar) const;
+    constexpr T dot(const Vector<T, size>& vector) const;
+
+    using VectorExpression<Vector<T, size>>::dot; /** Iloczyn skalarny z dowolnym wyrazeniem (np. widokiem wiersza) */
 
     /**
      * Operator indeksowania wektora
      * @param i
      * @return skalar na i-tej pozycji w wektorze
      */
-    T operator[](size_t i) const;
+    constexpr T operator[](size_t i) const;
 
     /**
      * Operator indeksowania wektora
      * @param i
      * @return referencje na skalar na i-tej pozycji w wektorze
      */
-    T& operator[](size_t i);
+    constexpr T& operator[](size_t i);
 
     /**
      * Operator indeksowania wektora ze sprawdzaniem granic
@@ -108,77 +120,89 @@ public:
     friend std::ostream& operator<<(std::ostream& out, const Vector<_T, _size>& vector);
 
 private:
-    T scalars[size];
+    T scalars[size]{};
 };
 
 template <class T, size_t size>
-Vector<T, size>::Vector(T scalar) {
+constexpr Vector<T, size>::Vector(T scalar) {
     for (size_t i = 0; i < size; i++)
         scalars[i] = scalar;
 }
 
 template <class T, size_t size>
-T Vector<T, size>::dot(const Vector<T, size>& vector) const {
-    T result = 0;
-    for (size_t i = 0; i < size; i++)
-        result += scalars[i] * vector.scalars[i];
-    return result;
+template <class E>
+constexpr Vector<T, size>::Vector(const VectorExpression<E>& expression) {
+    const E& vector = expression.derived();
+    if (vector.length() != size)
+        throw std::runtime_error("Size mismatch");
+
+    ExpressionEvaluator<E>::evaluate(vector, scalars);
 }
 
 template <class T, size_t size>
-T Vector<T, size>::operator[](const size_t i) const {
-    return scalars[i];
+template <class E>
+constexpr Vector<T, size>& Vector<T, size>::operator=(const VectorExpression<E>& expression) {
+    const E& vector = expression.derived();
+    if (vector.length() != size)
+        throw std::runtime_error("Size mismatch");
+
+    if (ExpressionOperand<E>::aliases(vector, scalars)) {
+        *this = Vector<T, size>(expression);
+        return *this;
+    }
+
+    ExpressionEvaluator<E>::evaluate(vector, scalars);
+    return *this;
 }
 
 template <class T, size_t size>
-T& Vector<T, size>::operator[](const size_t i) {
-    return scalars[i];
+constexpr size_t Vector<T, size>::length() {
+    return size;
 }
 
 template <class T, size_t size>
-T Vector<T, size>::operator()(const size_t i) const {
-    if (i >= size)
-        throw std::runtime_error("Index out of range");
-    return scalars[i];
+constexpr const T* Vector<T, size>::data() const {
+    return scalars;
 }
 
 template <class T, size_t size>
-T& Vector<T, size>::operator()(const size_t i) {
-    if (i >= size)
-        throw std::runtime_error("Index out of range");
-    return scalars[i];
+constexpr T* Vector<T, size>::data() {
+    return scalars;
 }
 
 template <class T, size_t size>
-Vector<T, size> Vector<T, size>::operator+(const Vector<T, size> &vector) const {
-    Vector<T, size> result;
+constexpr T Vector<T, size>::dot(const Vector<T, size>& vector) const {
+    if constexpr (Kernels<T>::vectorized && size >= kernel_threshold)
+        return Kernels<T>::dot(scalars, vector.scalars, size);
+
+    T result = 0;
     for (size_t i = 0; i < size; i++)
-        result.scalars[i] = scalars[i] + vector.scalars[i];
+        result += scalars[i] * vector.scalars[i];
     return result;
 }
 
 template <class T, size_t size>
-Vector<T, size> Vector<T, size>::operator-(const Vector<T, size> &vector) const {
-    Vector<T, size> result;
-    for (size_t i = 0; i < size; i++)
-        result.scalars[i] = scalars[i] - vector.scalars[i];
-    return result;
+constexpr T Vector<T, size>::operator[](const size_t i) const {
+    return scalars[i];
 }
 
 template <class T, size_t size>
-Vector<T, size> Vector<T, size>::operator*(T scalar) const {
-    Vector<T, size> result;
-    for (size_t i = 0; i < size; i++)
-        result.scalars[i] = scalars[i] * scalar;
-    return result;
+constexpr T& Vector<T, size>::operator[](const size_t i) {
+    return scalars[i];
 }
 
 template <class T, size_t size>
-Vector<T, size> Vector<T, size>::operator/(T scalar) const {
-    Vector<T, size> result;
-    for (size_t i = 0; i < size; i++)
-        result.scalars[i] = scalars[i] / scalar;
-    return result;
+T Vector<T, size>::operator()(const size_t i) const {
+    if (i >= size)
+        throw std::runtime_error("Index out of range");
+    return scalars[i];
+}
+
+template <class T, size_t size>
+T& Vector<T, size>::operator()(const size_t i) {
+    if (i >= size)
+        throw std::runtime_error("Index out of range");
+    return scalars[i];
 }
 
 template <class T, size_t size>
@@ -198,6 +222,28 @@ std::ostream& operator<<(std::ostream& out, const Vector<T, size>& vector) {
     return out;
 }
 
+/**
+ * Wektory przechowuja skalary w ciaglej pamieci
+ * @tparam T
+ * @tparam size
+ */
+template <class T, size_t size>
+struct Contiguous<Vector<T, size>> : std::true_type {};
+
+/**
+ * Wektory sa argumentami wyrazen przechowywanymi przez referencje
+ * @tparam T
+ * @tparam size
+ */
+template <class T, size_t size>
+struct ExpressionOperand<Vector<T, size>> {
+    using type = const Vector<T, size>&;
+
+    static constexpr bool aliases(const Vector<T, size>&, const void*) {
+        return false;
+    }
+};
+
 using Vector5d = Vector<double, 5>; /** Alias dla wektora 5 liczb rzeczywistych */
 using Vector5c = Vector<Complex<double>, 5>; /** Alias dla wektora 5 liczb zespolonych */
 
@@ -0,0 +1,378 @@
+#ifndef ZAD3_VECTOREXPRESSION_HH
+#define ZAD3_VECTOREXPRESSION_HH
+
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../inc/Kernels.hh"
+
+/* wyrazenia wektorowe nie licza niczego przy tworzeniu, skalary wyliczane sa dopiero
+ * przy przypisaniu do wektora, w jednej petli i bez wektorow posrednich */
+
+/**
+ * Sposob przechowywania argumentu wyrazenia: wyrazenia posrednie przez wartosc (sa lekkie
+ * i zwykle tymczasowe), wektory i macierze przez referencje (specjalizacje obok ich definicji)
+ * @tparam E
+ */
+template <class E>
+struct ExpressionOperand {
+    using type = const E; /** Typ pola przechowujacego argument */
+
+    /**
+     * Sprawdza, czy wyliczenie argumentu czyta pamiec wektora przy innych indeksach niz wyliczany
+     * @param expression
+     * @param data
+     * @return true jesli przypisanie wymaga wektora tymczasowego
+     */
+    static constexpr bool aliases(const E& expression, const void* data) {
+        return expression.aliases(data);
+    }
+};
+
+/**
+ * Informuje, czy wyrazenie E jest wektorem przechowujacym skalary w ciaglej pamieci (ma metode data());
+ * specjalizacje obok definicji wektorow
+ * @tparam E
+ */
+template <class E>
+struct Contiguous : std::false_type {};
+
+/**
+ * Wylicza cale wyrazenie do tablicy wyniku; domyslnie skalar po skalarze w jednej petli,
+ * specjalizacje moga uzyc szybszego jadra dla calego wyrazenia (np. iloczynu macierzy przez wektor)
+ * @tparam E
+ */
+template <class E>
+struct ExpressionEvaluator {
+    template <class T>
+    static constexpr void evaluate(const E& expression, T* result) {
+        for (size_t i = 0; i < expression.length(); i++)
+            result[i] = expression[i];
+    }
+};
+
+/**
+ * Baza wyrazen wektorowych
+ * @tparam Derived
+ */
+template <class Derived>
+struct VectorExpression {
+    /**
+     * Zwraca wyrazenie jako typ pochodny
+     * @return referencja na wyrazenie
+     */
+    constexpr const Derived& derived() const {
+        return static_cast<const Derived&>(*this);
+    }
+
+    /**
+     * Wylicza iloczyn skalarny z innym wyrazeniem, skalar po skalarze
+     * @param expression
+     * @return wartosc
+     */
+    template <class E>
+    constexpr auto dot(const VectorExpression<E>& expression) const {
+        const Derived& left = derived();
+        const E& right = expression.derived();
+        if (left.length() != right.length())
+            throw std::runtime_error("Size mismatch");
+
+        typename Derived::scalar_type result = 0;
+        for (size_t i = 0; i < left.length(); i++)
+            result += left[i] * right[i];
+        return result;
+    }
+};
+
+/**
+ * Dodawanie skalarow
+ */
+struct Addition {
+    template <class A, class B>
+    static constexpr auto apply(const A& a, const B& b) {
+        return a + b;
+    }
+};
+
+/**
+ * Odejmowanie skalarow
+ */
+struct Subtraction {
+    template <class A, class B>
+    static constexpr auto apply(const A& a, const B& b) {
+        return a - b;
+    }
+};
+
+/**
+ * Mnozenie skalarow
+ */
+struct Multiplication {
+    template <class A, class B>
+    static constexpr auto apply(const A& a, const B& b) {
+        return a * b;
+    }
+};
+
+/**
+ * Dzielenie skalarow
+ */
+struct Division {
+    template <class A, class B>
+    static constexpr auto apply(const A& a, const B& b) {
+        return a / b;
+    }
+};
+
+/**
+ * Wyrazenie dzialania na odpowiadajacych sobie skalarach dwoch wektorow
+ * @tparam L
+ * @tparam R
+ * @tparam Operation
+ */
+template <class L, class R, class Operation>
+class VectorBinaryExpression : public VectorExpression<VectorBinaryExpression<L, R, Operation>> {
+public:
+    using scalar_type = typename L::scalar_type;
+
+    /**
+     * Tworzy wyrazenie
+     * @param left
+     * @param right
+     */
+    constexpr VectorBinaryExpression(const L& left, const R& right) : left(left), right(right) {
+        if (left.length() != right.length())
+            throw std::runtime_error("Size mismatch");
+    }
+
+    /**
+     * Zwraca dlugosc wyniku
+     * @return dlugosc
+     */
+    constexpr size_t length() const {
+        return left.length();
+    }
+
+    /**
+     * Wylicza i-ty skalar wyniku
+     * @param i
+     * @return skalar
+     */
+    constexpr scalar_type operator[](size_t i) const {
+        return Operation::apply(left[i], right[i]);
+    }
+
+    /**
+     * @see ExpressionOperand::aliases
+     */
+    constexpr bool aliases(const void* data) const {
+        return ExpressionOperand<L>::aliases(left, data) || ExpressionOperand<R>::aliases(right, data);
+    }
+
+private:
+    typename ExpressionOperand<L>::type left;
+    typename ExpressionOperand<R>::type right;
+};
+
+/**
+ * Wyrazenie dzialania na skalarach wektora i jednym skalarze
+ * @tparam E
+ * @tparam Operation
+ */
+template <class E, class Operation>
+class VectorScalarExpression : public VectorExpression<VectorScalarExpression<E, Operation>> {
+public:
+    using scalar_type = typename E::scalar_type;
+
+    /**
+     * Tworzy wyrazenie
+     * @param expression
+     * @param scalar
+     */
+    constexpr VectorScalarExpression(const E& expression, const scalar_type& scalar) : expression(expression), scalar(scalar) {}
+
+    /**
+     * Zwraca dlugosc wyniku
+     * @return dlugosc
+     */
+    constexpr size_t length() const {
+        return expression.length();
+    }
+
+    /**
+     * Wylicza i-ty skalar wyniku
+     * @param i
+     * @return skalar
+     */
+    constexpr scalar_type operator[](size_t i) const {
+        return Operation::apply(expression[i], scalar);
+    }
+
+    /**
+     * @see ExpressionOperand::aliases
+     */
+    constexpr bool aliases(const void* data) const {
+        return ExpressionOperand<E>::aliases(expression, data);
+    }
+
+private:
+    typename ExpressionOperand<E>::type expression;
+    scalar_type scalar;
+};
+
+/**
+ * Wyrazenie iloczynu macierzy (lub widoku macierzy) przez wektor
+ * @tparam M
+ * @tparam V
+ */
+template <class M, class V>
+class MatrixVectorProduct : public VectorExpression<MatrixVectorProduct<M, V>> {
+public:
+    using scalar_type = typename M::scalar_type;
+
+    /**
+     * Tworzy wyrazenie
+     * @param matrix
+     * @param vector
+     */
+    constexpr MatrixVectorProduct(const M& matrix, const V& vector) : matrix_operand(matrix), vector_operand(vector) {
+        if (matrix.columns() != vector.length())
+            throw std::runtime_error("Size mismatch");
+    }
+
+    /**
+     * Zwraca dlugosc wyniku
+     * @return dlugosc
+     */
+    constexpr size_t length() const {
+        return matrix_operand.rows();
+    }
+
+    /**
+     * Wylicza x-ty skalar wyniku jako iloczyn skalarny x-tego wiersza i wektora
+     * @param x
+     * @return skalar
+     */
+    constexpr scalar_type operator[](size_t x) const {
+        decltype(auto) row = matrix_operand[x];
+        using Row = std::decay_t<decltype(row)>;
+
+        /* wiersz ciagly w pamieci (DynamicMatrix) lub wektor (Matrix) - iloczyn skalarny z jadrami SIMD */
+        if constexpr (std::is_pointer<Row>::value && Contiguous<V>::value) {
+            return Kernels<scalar_type>::dot(row, vector_operand.data(), vector_operand.length());
+        } else if constexpr (std::is_same<Row, std::decay_t<V>>::value) {
+            return row.dot(vector_operand);
+        } else {
+            scalar_type result = 0;
+            for (size_t y = 0; y < vector_operand.length(); y++)
+                result += row[y] * vector_operand[y];
+            return result;
+        }
+    }
+
+    /**
+     * Kazdy skalar wyniku czyta caly wektor, wiec przypisanie do niego wymaga wektora tymczasowego;
+     * wyrazenie (np. widok wiersza) moze czytac dowolna pamiec, wiec wtedy tymczasowy wektor jest zawsze
+     * @see ExpressionOperand::aliases
+     */
+    constexpr bool aliases(const void* data) const {
+        if constexpr (Contiguous<V>::value)
+            return vector_operand.data() == data;
+        else
+            return true;
+    }
+
+    /**
+     * Zwraca macierz bedaca argumentem iloczynu
+     * @return referencja na macierz
+     */
+    constexpr const M& matrix() const {
+        return matrix_operand;
+    }
+
+    /**
+     * Zwraca wektor bedacy argumentem iloczynu
+     * @return referencja na wektor
+     */
+    constexpr const V& vector() const {
+        return vector_operand;
+    }
+
+private:
+    typename ExpressionOperand<M>::type matrix_operand;
+    typename ExpressionOperand<V>::type vector_operand;
+};
+
+/**
+ * Operator dodawania wektorow
+ * @param left
+ * @param right
+ * @return wyrazenie
+ */
+template <class L, class R>
+constexpr VectorBinaryExpression<L, R, Addition> operator+(const VectorExpression<L>& left, const VectorExpression<R>& right) {
+    return VectorBinaryExpression<L, R, Addition>(left.derived(), right.derived());
+}
+
+/**
+ * Operator odejmowania wektorow
+ * @param left
+ * @param right
+ * @return wyrazenie
+ */
+template <class L, class R>
+constexpr VectorBinaryExpression<L, R, Subtraction> operator-(const VectorExpression<L>& left, const VectorExpression<R>& right) {
+    return VectorBinaryExpression<L, R, Subtraction>(left.derived(), right.derived());
+}
+
+/**
+ * Operator mnozenia wektora przez skalar
+ * @param expression
+ * @param scalar
+ * @return wyrazenie
+ */
+template <class E>
+constexpr VectorScalarExpression<E, Multiplication> operator*(const VectorExpression<E>& expression, const typename E::scalar_type& scalar) {
+    return VectorScalarExpression<E, Multiplication>(expression.derived(), scalar);
+}
+
+/**
+ * Operator mnozenia skalara przez wektor
+ * @param scalar
+ * @param expression
+ * @return wyrazenie
+ */
+template <class E>
+constexpr VectorScalarExpression<E, Multiplication> operator*(const typename E::scalar_type& scalar, const VectorExpression<E>& expression) {
+    return VectorScalarExpression<E, Multiplication>(expression.derived(), scalar);
+}
+
+/**
+ * Operator dzielenia wektora przez skalar
+ * @param expression
+ * @param scalar
+ * @return wyrazenie
+ */
+template <class E>
+constexpr VectorScalarExpression<E, Division> operator/(const VectorExpression<E>& expression, const typename E::scalar_type& scalar) {
+    return VectorScalarExpression<E, Division>(expression.derived(), scalar);
+}
+
+/**
+ * Przeladowany operator wyjscia, wylicza wyrazenie skalar po skalarze
+ * @param out
+ * @param expression
+ */
+template <class E>
+std::ostream& operator<<(std::ostream& out, const VectorExpression<E>& expression) {
+    const E& vector = expression.derived();
+    for (size_t i = 0; i < vector.length(); i++) {
+        out << vector[i];
+        if (i < vector.length() - 1)
+            out << " ";
+    }
+    return out;
+}
+
+#endif //ZAD3_VECTOREXPRESSION_HH
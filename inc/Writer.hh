@@ -0,0 +1,150 @@
+#ifndef ZAD3_WRITER_HH
+#define ZAD3_WRITER_HH
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "../inc/Complex.hh"
+#include "../inc/Vector.hh"
+#include "../inc/DynamicVector.hh"
+
+/* skalary zapisywane sa przez std::to_chars do wlasnego bufora, ktory trafia do strumienia dopiero po
+ * zapelnieniu; z domyslna precyzja tekst jest identyczny jak z operator<< na strumieniu z domyslnymi
+ * flagami (%g z 6 cyframi), a liczby zespolone maja ten sam format (re+imi) */
+
+/**
+ * Buforowane wypisywanie tekstu, skalarow i wektorow do strumienia
+ */
+class Writer {
+public:
+    static constexpr int shortest = -1; /** Precyzja: najkrotszy zapis, z ktorego wczytuje sie ta sama liczba */
+    static constexpr int default_precision = 6; /** Domyslna precyzja strumieni */
+    static constexpr size_t default_capacity = 1 << 16; /** Domyslny rozmiar bufora */
+
+    /**
+     * Tworzy pusty bufor
+     * @param out strumien, do ktorego trafia tekst
+     * @param precision liczba cyfr znaczacych lub shortest
+     * @param capacity rozmiar bufora
+     */
+    explicit Writer(std::ostream& out, int precision = default_precision, size_t capacity = default_capacity);
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /**
+     * Przekazuje reszte bufora do strumienia
+     */
+    ~Writer();
+
+    /**
+     * Zwraca precyzje
+     * @return liczba cyfr znaczacych lub shortest
+     */
+    int precision() const;
+
+    /**
+     * Ustawia precyzje kolejnych skalarow
+     * @param digits liczba cyfr znaczacych lub shortest
+     */
+    void precision(int digits);
+
+    /**
+     * Zwraca liczbe zapisanych bajtow, razem z tymi, ktore sa jeszcze w buforze
+     * @return liczba bajtow
+     */
+    size_t written() const;
+
+    /**
+     * Przekazuje bufor do strumienia (bez oprozniania samego strumienia)
+     */
+    void flush();
+
+    Writer& operator<<(char character);
+    Writer& operator<<(const char* text);
+    Writer& operator<<(const std::string& text);
+    Writer& operator<<(size_t value);
+    Writer& operator<<(double value);
+    Writer& operator<<(float value);
+
+    /**
+     * Zapisuje liczbe zespolona w formacie (re+imi)
+     * @tparam T
+     * @param complex
+     * @return this
+     */
+    template <class T>
+    Writer& operator<<(const Complex<T>& complex);
+
+    /**
+     * Zapisuje skladowe wektora oddzielone spacjami
+     * @tparam T
+     * @param vector
+     * @return this
+     */
+    template <class T>
+    Writer& operator<<(const DynamicVector<T>& vector);
+
+    /**
+     * @see operator<<(const DynamicVector<T>&)
+     */
+    template <class T, size_t size>
+    Writer& operator<<(const Vector<T, size>& vector);
+
+private:
+    std::ostream& out; /** Strumien docelowy */
+    std::unique_ptr<char[]> buffer; /** Bufor */
+    size_t capacity; /** Rozmiar bufora */
+    size_t length = 0; /** Liczba bajtow w buforze */
+    size_t flushed = 0; /** Liczba bajtow przekazanych do strumienia */
+    int digits; /** Precyzja */
+
+    /**
+     * Dopisuje tekst, przekazujac bufor do strumienia, gdy sie zapelni
+     * @param text
+     * @param count
+     */
+    void append(const char* text, size_t count);
+
+    /**
+     * Zapisuje liczbe
+     * @tparam T float lub double
+     * @param value
+     * @param sign czy nieujemne liczby poprzedzic znakiem + (jak std::showpos)
+     */
+    template <class T>
+    void number(T value, bool sign);
+};
+
+template <class T>
+Writer& Writer::operator<<(const Complex<T>& complex) {
+    *this << Complex<T>::opening_parenthesis;
+    number(complex.real, false);
+    number(complex.imaginary, true);
+    *this << Complex<T>::i << Complex<T>::closing_parenthesis;
+    return *this;
+}
+
+template <class T>
+Writer& Writer::operator<<(const DynamicVector<T>& vector) {
+    for (size_t i = 0; i < vector.length(); i++) {
+        if (i > 0)
+            *this << ' ';
+        *this << vector[i];
+    }
+    return *this;
+}
+
+template <class T, size_t size>
+Writer& Writer::operator<<(const Vector<T, size>& vector) {
+    for (size_t i = 0; i < size; i++) {
+        if (i > 0)
+            *this << ' ';
+        *this << vector[i];
+    }
+    return *this;
+}
+
+#endif //ZAD3_WRITER_HH
@@ -0,0 +1,93 @@
+#include "../inc/Arena.hh"
+
+#include <cstdint>
+
+/**
+ * Zaokragla w gore do wielokrotnosci potegi dwojki
+ * @param value
+ * @param boundary
+ * @return wartosc
+ */
+static size_t round_up(const size_t value, const size_t boundary) {
+    return (value + boundary - 1) & ~(boundary - 1);
+}
+
+Arena::Arena(const size_t chunk_size) : next_size(round_up(chunk_size > 0 ? chunk_size : alignment, alignment)) {}
+
+void Arena::reset() {
+    /* wiele fragmentow zastepowanych jest jednym o lacznym rozmiarze, zeby nastepny przebieg sie w nim zmiescil */
+    if (chunks.size() > 1) {
+        const size_t total = capacity();
+        chunks.clear();
+        current.store(nullptr, std::memory_order_relaxed);
+        grow(nullptr, total);
+    } else if (!chunks.empty()) {
+        chunks.front()->used.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+}
+
+size_t Arena::allocations() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+size_t Arena::used() const {
+    size_t result = 0;
+    for (const std::unique_ptr<Chunk>& chunk : chunks) {
+        const size_t offset = chunk->used.load(std::memory_order_relaxed);
+        result += offset < chunk->size ? offset : chunk->size;
+    }
+    return result;
+}
+
+size_t Arena::capacity() const {
+    size_t result = 0;
+    for (const std::unique_ptr<Chunk>& chunk : chunks)
+        result += chunk->size;
+    return result;
+}
+
+void Arena::grow(const Chunk* seen, const size_t bytes) {
+    const std::lock_guard<std::mutex> lock(growth);
+    if (current.load(std::memory_order_acquire) != seen)
+        return;
+
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+    chunk->size = round_up(bytes > next_size ? bytes : next_size, alignment);
+    chunk->data.reset(new char[chunk->size + alignment]);
+    const uintptr_t address = reinterpret_cast<uintptr_t>(chunk->data.get());
+    chunk->begin = chunk->data.get() + (round_up(address, alignment) - address);
+    next_size = 2 * chunk->size;
+
+    current.store(chunk.get(), std::memory_order_release);
+    chunks.push_back(std::move(chunk));
+}
+
+void* Arena::do_allocate(size_t bytes, const size_t requested) {
+    /* kazdy obiekt zaczyna sie na granicy linii cache; wieksze wyrownanie wymaga zapasu */
+    bytes = round_up(bytes > 0 ? bytes : 1, alignment);
+    const size_t extra = requested > alignment ? requested : 0;
+
+    for (;;) {
+        Chunk* chunk = current.load(std::memory_order_acquire);
+        if (chunk != nullptr) {
+            const size_t offset = chunk->used.fetch_add(bytes + extra, std::memory_order_relaxed);
+            if (offset + bytes + extra <= chunk->size) {
+                count.fetch_add(1, std::memory_order_relaxed);
+                char* pointer = chunk->begin + offset;
+                if (extra > 0) {
+                    const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+                    pointer += round_up(address, requested) - address;
+                }
+                return pointer;
+            }
+        }
+        grow(chunk, bytes + extra);
+    }
+}
+
+void Arena::do_deallocate(void*, size_t, size_t) {}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,145 @@
+#include "../inc/Benchmark.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <numeric>
+
+#include "../inc/Kernels.hh"
+
+/* globalny operator new zastapiony wersja liczaca wywolania; pozostale odmiany (tablicowe, nothrow)
+ * w bibliotece standardowej wolaja te ponizej, wiec liczone sa wszystkie alokacje programu */
+
+static std::atomic<uint64_t> allocation_count{0}; /** Liczba alokacji */
+
+void* operator new(const size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size > 0 ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    const size_t boundary = static_cast<size_t>(alignment);
+    if (void* pointer = std::aligned_alloc(boundary, (size + boundary - 1) / boundary * boundary + (size == 0 ? boundary : 0)))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+uint64_t Benchmark::allocations() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * Zwraca percentyl posortowanych probek metoda najblizszej pozycji
+ * @param sorted
+ * @param fraction
+ * @return wartosc
+ */
+static double percentile(const std::vector<double>& sorted, const double fraction) {
+    const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+    return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+BenchmarkStatistics BenchmarkStatistics::of(std::vector<double> samples) {
+    BenchmarkStatistics statistics;
+    if (samples.empty())
+        return statistics;
+
+    std::sort(samples.begin(), samples.end());
+    const size_t n = samples.size();
+
+    statistics.min = samples.front();
+    statistics.median = n % 2 == 1 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    statistics.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(n);
+    statistics.p90 = percentile(samples, 0.9);
+    statistics.p99 = percentile(samples, 0.99);
+    statistics.max = samples.back();
+    return statistics;
+}
+
+std::string BenchmarkResult::name() const {
+    return group + "/" + scalar + "/" + std::to_string(size);
+}
+
+const std::vector<BenchmarkResult>& Benchmark::results() const {
+    return measured;
+}
+
+bool Benchmark::selected(const std::string& name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+void Benchmark::report(const BenchmarkResult& result) {
+    std::cerr << std::left << std::setw(40) << result.name() << std::right << std::fixed << std::setprecision(1)
+              << std::setw(16) << result.nanoseconds.median << " ns" << std::defaultfloat << std::endl;
+}
+
+void Benchmark::write_table(std::ostream& out) const {
+    out << std::left << std::setw(40) << "pomiar" << std::right;
+    for (const char* column : {"min", "mediana", "p90", "p99", "max", "alokacje"})
+        out << std::setw(16) << column;
+    out << '\n' << std::fixed << std::setprecision(1);
+
+    for (const BenchmarkResult& result : measured) {
+        const BenchmarkStatistics& time = result.nanoseconds;
+        out << std::left << std::setw(40) << result.name() << std::right;
+        for (const double value : {time.min, time.median, time.p90, time.p99, time.max, result.allocations})
+            out << std::setw(16) << value;
+        out << '\n';
+    }
+    out << std::defaultfloat;
+}
+
+void Benchmark::write_json(std::ostream& out) const {
+    /* nazwy pomiarow i typow skladaja sie z liter, cyfr i znakow /<>_, wiec nie wymagaja cytowania */
+    out << "{\n";
+    out << "  \"isa\": \"" << Kernels<double>::isa() << "\",\n";
+    out << "  \"warmup\": " << warmup << ",\n";
+    out << "  \"samples\": " << samples << ",\n";
+    out << "  \"sample_time_ns\": " << sample_time.count() << ",\n";
+    out << "  \"benchmarks\": [";
+
+    out << std::setprecision(6);
+    for (size_t i = 0; i < measured.size(); i++) {
+        const BenchmarkResult& result = measured[i];
+        const BenchmarkStatistics& time = result.nanoseconds;
+
+        out << (i > 0 ? ",\n" : "\n") << "    {";
+        out << "\"name\": \"" << result.name() << "\", ";
+        out << "\"group\": \"" << result.group << "\", ";
+        out << "\"scalar\": \"" << result.scalar << "\", ";
+        out << "\"size\": " << result.size << ", ";
+        out << "\"iterations\": " << result.iterations << ", ";
+        out << "\"samples\": " << result.samples << ", ";
+        out << "\"min_ns\": " << time.min << ", ";
+        out << "\"median_ns\": " << time.median << ", ";
+        out << "\"mean_ns\": " << time.mean << ", ";
+        out << "\"p90_ns\": " << time.p90 << ", ";
+        out << "\"p99_ns\": " << time.p99 << ", ";
+        out << "\"max_ns\": " << time.max << ", ";
+        out << "\"allocations\": " << result.allocations << "}";
+    }
+    out << (measured.empty() ? "]\n" : "\n  ]\n") << "}\n";
+}
@@ -0,0 +1,59 @@
+#include "../inc/BinaryFormat.hh"
+
+BinaryFile::BinaryFile(const std::string& path) : BinaryFile(MappedFile(path)) {}
+
+BinaryFile::BinaryFile(MappedFile&& mapped) : file(std::move(mapped)) {
+    if (!detect(file.data(), file.size()))
+        throw std::runtime_error("Invalid binary file");
+
+    const BinaryHeader& header = this->header();
+    if (header.byte_order != binary_byte_order)
+        throw std::runtime_error("Unsupported byte order");
+    if (header.version != binary_version)
+        throw std::runtime_error("Unsupported binary format version");
+    if (header.content > static_cast<uint8_t>(BinaryContent::solutions))
+        throw std::runtime_error("Invalid binary file");
+    if (header.width != sizeof(float) && header.width != sizeof(double))
+        throw std::runtime_error("Unsupported scalar width");
+    if (header.size == 0 && header.count != 0)
+        throw std::runtime_error("Invalid binary file");
+
+    /* rozmiar sprawdzany dzieleniem, zeby uszkodzony naglowek nie przepelnil mnozenia */
+    if (header.size > 0 && (file.size() - sizeof(BinaryHeader)) / stride() < header.count)
+        throw std::runtime_error("Truncated binary file");
+}
+
+bool BinaryFile::detect(const char* data, const size_t size) {
+    return size >= sizeof(BinaryHeader) && std::memcmp(data, binary_magic, sizeof(binary_magic)) == 0;
+}
+
+const BinaryHeader& BinaryFile::header() const {
+    return *reinterpret_cast<const BinaryHeader*>(file.data());
+}
+
+size_t BinaryFile::size() const {
+    return header().size;
+}
+
+size_t BinaryFile::count() const {
+    return header().count;
+}
+
+BinaryContent BinaryFile::content() const {
+    return static_cast<BinaryContent>(header().content);
+}
+
+size_t BinaryFile::second_offset() const {
+    const size_t scalar = header().width * (header().complex ? 2 : 1);
+    const size_t first = content() == BinaryContent::systems ? size() * size() : size();
+    return binary_align(first * scalar);
+}
+
+size_t BinaryFile::stride() const {
+    const size_t scalar = header().width * (header().complex ? 2 : 1);
+    return second_offset() + binary_align(size() * scalar);
+}
+
+void BinaryFile::release(const size_t i) {
+    file.release(sizeof(BinaryHeader) + i * stride());
+}
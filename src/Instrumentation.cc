@@ -0,0 +1,183 @@
+#include "../inc/Instrumentation.hh"
+
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+/**
+ * Liczniki jednego etapu
+ */
+struct PhaseCounters {
+    std::atomic<uint64_t> calls{0}; /** Liczba wykonan */
+    std::atomic<uint64_t> nanoseconds{0}; /** Laczny czas */
+    std::atomic<uint64_t> flops{0}; /** Laczna liczba dzialan */
+    std::atomic<uint64_t> bytes{0}; /** Laczna liczba bajtow */
+};
+
+static PhaseCounters phases[static_cast<size_t>(Phase::count)];
+
+static std::atomic<uint64_t> decompositions{0}; /** Liczba rozkladow */
+static std::atomic<uint64_t> pivots{0}; /** Liczba elementow glownych */
+static std::atomic<uint64_t> moved_rows{0}; /** Liczba wierszy przestawionych przez wybor elementu glownego */
+static std::atomic<double> smallest_pivot{std::numeric_limits<double>::infinity()}; /** Najmniejszy modul */
+static std::atomic<double> largest_pivot{0}; /** Najwiekszy modul */
+
+/* sciezka ustalana raz w install(), bo getenv nie jest bezpieczne w obsludze sygnalu */
+static char output_path[4096];
+
+static const char* const phase_names[] = {"parse", "load", "factorization", "substitution", "residual", "output"};
+
+/**
+ * Bufor tekstu o stalym rozmiarze, wypelniany bez alokacji pamieci
+ */
+class FixedWriter {
+public:
+    /**
+     * Dopisuje napis, jesli sie miesci
+     * @param value
+     */
+    void text(const char* value) {
+        const size_t length = std::strlen(value);
+        if (length <= sizeof(buffer) - used) {
+            std::memcpy(buffer + used, value, length);
+            used += length;
+        }
+    }
+
+    /**
+     * Dopisuje liczbe w najkrotszej postaci, jesli sie miesci
+     * @tparam N
+     * @param value
+     */
+    template <class N>
+    void number(const N value) {
+        const std::to_chars_result result = std::to_chars(buffer + used, buffer + sizeof(buffer), value);
+        if (result.ec == std::errc())
+            used = static_cast<size_t>(result.ptr - buffer);
+    }
+
+    /**
+     * Zapisuje bufor do deskryptora
+     * @param descriptor
+     */
+    void flush(const int descriptor) const {
+        for (size_t written = 0; written < used;) {
+            const ssize_t result = write(descriptor, buffer + written, used - written);
+            if (result <= 0)
+                return;
+            written += static_cast<size_t>(result);
+        }
+    }
+
+private:
+    char buffer[4096]{}; /** Tekst */
+    size_t used = 0; /** Liczba zapisanych znakow */
+};
+
+void Instrumentation::record(const Phase phase, const uint64_t nanoseconds, const uint64_t flops, const uint64_t bytes) {
+    PhaseCounters& counters = phases[static_cast<size_t>(phase)];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    counters.flops.fetch_add(flops, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Instrumentation::record_pivots(const double smallest, const double largest, const uint64_t count, const uint64_t moved) {
+    decompositions.fetch_add(1, std::memory_order_relaxed);
+    pivots.fetch_add(count, std::memory_order_relaxed);
+    moved_rows.fetch_add(moved, std::memory_order_relaxed);
+
+    double current = smallest_pivot.load(std::memory_order_relaxed);
+    while (smallest < current && !smallest_pivot.compare_exchange_weak(current, smallest, std::memory_order_relaxed)) {}
+    current = largest_pivot.load(std::memory_order_relaxed);
+    while (largest > current && !largest_pivot.compare_exchange_weak(current, largest, std::memory_order_relaxed)) {}
+}
+
+void Instrumentation::dump(const int descriptor) {
+    FixedWriter out;
+    out.text("{\n  \"phases\": {");
+
+    for (size_t i = 0; i < static_cast<size_t>(Phase::count); i++) {
+        const PhaseCounters& counters = phases[i];
+        out.text(i > 0 ? ",\n    \"" : "\n    \"");
+        out.text(phase_names[i]);
+        out.text("\": {\"calls\": ");
+        out.number(counters.calls.load(std::memory_order_relaxed));
+        out.text(", \"nanoseconds\": ");
+        out.number(counters.nanoseconds.load(std::memory_order_relaxed));
+        out.text(", \"flops\": ");
+        out.number(counters.flops.load(std::memory_order_relaxed));
+        out.text(", \"bytes\": ");
+        out.number(counters.bytes.load(std::memory_order_relaxed));
+        out.text("}");
+    }
+
+    /* przed pierwszym rozkladem najmniejszy modul jest nieskonczony, czego JSON nie zapisuje */
+    const uint64_t count = decompositions.load(std::memory_order_relaxed);
+    out.text("\n  },\n  \"pivots\": {\"decompositions\": ");
+    out.number(count);
+    out.text(", \"pivots\": ");
+    out.number(pivots.load(std::memory_order_relaxed));
+    out.text(", \"moved_rows\": ");
+    out.number(moved_rows.load(std::memory_order_relaxed));
+    out.text(", \"smallest\": ");
+    if (count > 0)
+        out.number(smallest_pivot.load(std::memory_order_relaxed));
+    else
+        out.text("null");
+    out.text(", \"largest\": ");
+    if (count > 0)
+        out.number(largest_pivot.load(std::memory_order_relaxed));
+    else
+        out.text("null");
+    out.text("}\n}\n");
+
+    out.flush(descriptor);
+}
+
+/**
+ * Zapisuje podsumowanie do pliku output_path lub na standardowe wyjscie bledow
+ */
+static void dump_to_output() {
+    if (output_path[0] == 0) {
+        Instrumentation::dump(STDERR_FILENO);
+        return;
+    }
+
+    const int descriptor = open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0)
+        return;
+    Instrumentation::dump(descriptor);
+    close(descriptor);
+}
+
+/**
+ * Obsluga SIGUSR1: zapis podsumowania bez przerywania programu
+ * @param signal
+ */
+static void dump_on_signal(int) {
+    const int saved = errno;
+    dump_to_output();
+    errno = saved;
+}
+
+void Instrumentation::install() {
+    const char* path = std::getenv("ZAD3_INSTRUMENTATION_OUTPUT");
+    if (path != nullptr && std::strlen(path) < sizeof(output_path))
+        std::strcpy(output_path, path);
+
+    std::atexit(dump_to_output);
+
+    struct sigaction action{};
+    action.sa_handler = dump_on_signal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, nullptr);
+}
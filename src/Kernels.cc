@@ -0,0 +1,317 @@
+#include "../inc/Kernels.hh"
+#include "../inc/SimdKernels.hh"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+struct Sse2Double {
+    using scalar = double;
+    using vector = __m128d;
+    using mask = __m128d;
+    static constexpr size_t width = 2;
+
+    static vector zero() { return _mm_setzero_pd(); }
+    static vector load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, vector v) { _mm_storeu_pd(p, v); }
+    static vector broadcast(double a) { return _mm_set1_pd(a); }
+    static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+    static vector sub(vector a, vector b) { return _mm_sub_pd(a, b); }
+    static vector mul(vector a, vector b) { return _mm_mul_pd(a, b); }
+    static vector div(vector a, vector b) { return _mm_div_pd(a, b); }
+    static vector fma(vector a, vector b, vector c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static vector fnma(vector a, vector b, vector c) { return _mm_sub_pd(c, _mm_mul_pd(a, b)); }
+    static double reduce(vector v) { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+    static vector abs(vector a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static mask greater(vector a, vector b) { return _mm_cmpgt_pd(a, b); }
+    static mask equal(vector a, vector b) { return _mm_cmpeq_pd(a, b); }
+    static vector select(mask m, vector a, vector b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static unsigned bits(mask m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+};
+
+struct Sse2Float {
+    using scalar = float;
+    using vector = __m128;
+    using mask = __m128;
+    static constexpr size_t width = 4;
+
+    static vector zero() { return _mm_setzero_ps(); }
+    static vector load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, vector v) { _mm_storeu_ps(p, v); }
+    static vector broadcast(float a) { return _mm_set1_ps(a); }
+    static vector add(vector a, vector b) { return _mm_add_ps(a, b); }
+    static vector sub(vector a, vector b) { return _mm_sub_ps(a, b); }
+    static vector mul(vector a, vector b) { return _mm_mul_ps(a, b); }
+    static vector div(vector a, vector b) { return _mm_div_ps(a, b); }
+    static vector fma(vector a, vector b, vector c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static vector fnma(vector a, vector b, vector c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+
+    static float reduce(vector v) {
+        const __m128 sum = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+    }
+
+    static vector abs(vector a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static mask greater(vector a, vector b) { return _mm_cmpgt_ps(a, b); }
+    static mask equal(vector a, vector b) { return _mm_cmpeq_ps(a, b); }
+    static vector select(mask m, vector a, vector b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static unsigned bits(mask m) { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+};
+#endif
+
+#ifdef ZAD3_HAVE_AVX2
+KernelTable<double> avx2_kernels_double();
+KernelTable<float> avx2_kernels_float();
+#endif
+
+#ifdef ZAD3_HAVE_AVX512
+KernelTable<double> avx512_kernels_double();
+KernelTable<float> avx512_kernels_float();
+#endif
+
+/**
+ * Zestaw instrukcji wybrany dla biezacego procesora
+ */
+enum class Isa {
+    scalar, sse2, avx2, avx512 /** Kolejno od najslabszego, kazdy procesor ma tez wszystkie poprzednie */
+};
+
+/**
+ * Wykrywa najlepszy zestaw instrukcji dostepny jednoczesnie w procesorze i w skompilowanym programie
+ * @return zestaw instrukcji
+ */
+static Isa detect_isa() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+#ifdef ZAD3_HAVE_AVX512
+    if (__builtin_cpu_supports("avx512f"))
+        return Isa::avx512;
+#endif
+#ifdef ZAD3_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return Isa::avx2;
+#endif
+#endif
+#if defined(__SSE2__)
+    return Isa::sse2;
+#else
+    return Isa::scalar;
+#endif
+}
+
+static Isa isa() {
+    static const Isa result = detect_isa();
+    return result;
+}
+
+static const char* isa_name(const Isa isa) {
+    switch (isa) {
+        case Isa::avx512: return "avx512";
+        case Isa::avx2: return "avx2";
+        case Isa::sse2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+/**
+ * Zwraca tablice jader zestawu instrukcji (zestaw niedostepny w programie zastepowany jest jadrami ogolnymi)
+ * @param isa
+ * @return tablica
+ */
+static KernelTable<double> table_double(const Isa isa) {
+    switch (isa) {
+#ifdef ZAD3_HAVE_AVX512
+        case Isa::avx512: return avx512_kernels_double();
+#endif
+#ifdef ZAD3_HAVE_AVX2
+        case Isa::avx2: return avx2_kernels_double();
+#endif
+#if defined(__SSE2__)
+        case Isa::sse2: return SimdKernels<Sse2Double>::table();
+#endif
+        default: return SimdKernels<ScalarSimd<double>>::table();
+    }
+}
+
+static const KernelTable<double>& kernels_double() {
+    static const KernelTable<double> table = table_double(isa());
+    return table;
+}
+
+/**
+ * @see table_double
+ */
+static KernelTable<float> table_float(const Isa isa) {
+    switch (isa) {
+#ifdef ZAD3_HAVE_AVX512
+        case Isa::avx512: return avx512_kernels_float();
+#endif
+#ifdef ZAD3_HAVE_AVX2
+        case Isa::avx2: return avx2_kernels_float();
+#endif
+#if defined(__SSE2__)
+        case Isa::sse2: return SimdKernels<Sse2Float>::table();
+#endif
+        default: return SimdKernels<ScalarSimd<float>>::table();
+    }
+}
+
+static const KernelTable<float>& kernels_float() {
+    static const KernelTable<float> table = table_float(isa());
+    return table;
+}
+
+double Kernels<double>::dot(const double* a, const double* b, const size_t n) {
+    return kernels_double().dot(a, b, n);
+}
+
+void Kernels<double>::axpy(const double alpha, const double* x, double* y, const size_t n) {
+    kernels_double().axpy(alpha, x, y, n);
+}
+
+void Kernels<double>::scale(const double alpha, double* x, const size_t n) {
+    kernels_double().scale(alpha, x, n);
+}
+
+void Kernels<double>::matvec(const double* matrix, const size_t stride, const double* x, double* y, const size_t rows, const size_t columns) {
+    kernels_double().matvec(matrix, stride, x, y, rows, columns);
+}
+
+void Kernels<double>::gemm_subtract(const double* a, const size_t a_stride, const double* b, const size_t b_stride,
+                                   double* c, const size_t c_stride, const size_t rows, const size_t columns, const size_t depth) {
+    kernels_double().gemm_subtract(a, a_stride, b, b_stride, c, c_stride, rows, columns, depth);
+}
+
+void Kernels<double>::complex_dot(const double* a_real, const double* a_imaginary, const double* b_real, const double* b_imaginary,
+                                 const size_t n, double& real, double& imaginary) {
+    kernels_double().complex_dot(a_real, a_imaginary, b_real, b_imaginary, n, real, imaginary);
+}
+
+void Kernels<double>::complex_axpy(const double alpha_real, const double alpha_imaginary, const double* x_real, const double* x_imaginary,
+                                  double* y_real, double* y_imaginary, const size_t n) {
+    kernels_double().complex_axpy(alpha_real, alpha_imaginary, x_real, x_imaginary, y_real, y_imaginary, n);
+}
+
+void Kernels<double>::complex_multiply(const double* a_real, const double* a_imaginary, const double* b_real, const double* b_imaginary,
+                                      double* c_real, double* c_imaginary, const size_t n) {
+    kernels_double().complex_multiply(a_real, a_imaginary, b_real, b_imaginary, c_real, c_imaginary, n);
+}
+
+void Kernels<double>::complex_divide(const double* a_real, const double* a_imaginary, const double* b_real, const double* b_imaginary,
+                                    double* c_real, double* c_imaginary, const size_t n) {
+    kernels_double().complex_divide(a_real, a_imaginary, b_real, b_imaginary, c_real, c_imaginary, n);
+}
+
+void Kernels<double>::complex_matvec(const double* matrix_real, const double* matrix_imaginary, const size_t stride,
+                                    const double* x_real, const double* x_imaginary, double* y_real, double* y_imaginary,
+                                    const size_t rows, const size_t columns) {
+    kernels_double().complex_matvec(matrix_real, matrix_imaginary, stride, x_real, x_imaginary, y_real, y_imaginary, rows, columns);
+}
+
+unsigned Kernels<double>::lane_solve(const double* system, const size_t n, double* solution, double* pivots) {
+    return kernels_double().lane_solve(system, n, solution, pivots);
+}
+
+unsigned Kernels<double>::complex_lane_solve(const double* system_real, const double* system_imaginary, const size_t n,
+                                             double* solution_real, double* solution_imaginary, double* pivots) {
+    return kernels_double().complex_lane_solve(system_real, system_imaginary, n, solution_real, solution_imaginary, pivots);
+}
+
+void Kernels<double>::lane_residual(const double* system, const size_t n, const double* solution, double* error) {
+    kernels_double().lane_residual(system, n, solution, error);
+}
+
+void Kernels<double>::complex_lane_residual(const double* system_real, const double* system_imaginary, const size_t n,
+                                            const double* solution_real, const double* solution_imaginary, double* error_real, double* error_imaginary) {
+    kernels_double().complex_lane_residual(system_real, system_imaginary, n, solution_real, solution_imaginary, error_real, error_imaginary);
+}
+
+const char* Kernels<double>::isa() {
+    return isa_name(::isa());
+}
+
+size_t Kernels<double>::variants() {
+    return static_cast<size_t>(::isa()) + 1;
+}
+
+KernelTable<double> Kernels<double>::variant(const size_t i, const char*& name) {
+    name = isa_name(static_cast<Isa>(i));
+    return table_double(static_cast<Isa>(i));
+}
+
+float Kernels<float>::dot(const float* a, const float* b, const size_t n) {
+    return kernels_float().dot(a, b, n);
+}
+
+void Kernels<float>::axpy(const float alpha, const float* x, float* y, const size_t n) {
+    kernels_float().axpy(alpha, x, y, n);
+}
+
+void Kernels<float>::scale(const float alpha, float* x, const size_t n) {
+    kernels_float().scale(alpha, x, n);
+}
+
+void Kernels<float>::matvec(const float* matrix, const size_t stride, const float* x, float* y, const size_t rows, const size_t columns) {
+    kernels_float().matvec(matrix, stride, x, y, rows, columns);
+}
+
+void Kernels<float>::gemm_subtract(const float* a, const size_t a_stride, const float* b, const size_t b_stride,
+                                   float* c, const size_t c_stride, const size_t rows, const size_t columns, const size_t depth) {
+    kernels_float().gemm_subtract(a, a_stride, b, b_stride, c, c_stride, rows, columns, depth);
+}
+
+void Kernels<float>::complex_dot(const float* a_real, const float* a_imaginary, const float* b_real, const float* b_imaginary,
+                                 const size_t n, float& real, float& imaginary) {
+    kernels_float().complex_dot(a_real, a_imaginary, b_real, b_imaginary, n, real, imaginary);
+}
+
+void Kernels<float>::complex_axpy(const float alpha_real, const float alpha_imaginary, const float* x_real, const float* x_imaginary,
+                                  float* y_real, float* y_imaginary, const size_t n) {
+    kernels_float().complex_axpy(alpha_real, alpha_imaginary, x_real, x_imaginary, y_real, y_imaginary, n);
+}
+
+void Kernels<float>::complex_multiply(const float* a_real, const float* a_imaginary, const float* b_real, const float* b_imaginary,
+                                      float* c_real, float* c_imaginary, const size_t n) {
+    kernels_float().complex_multiply(a_real, a_imaginary, b_real, b_imaginary, c_real, c_imaginary, n);
+}
+
+void Kernels<float>::complex_divide(const float* a_real, const float* a_imaginary, const float* b_real, const float* b_imaginary,
+                                    float* c_real, float* c_imaginary, const size_t n) {
+    kernels_float().complex_divide(a_real, a_imaginary, b_real, b_imaginary, c_real, c_imaginary, n);
+}
+
+void Kernels<float>::complex_matvec(const float* matrix_real, const float* matrix_imaginary, const size_t stride,
+                                    const float* x_real, const float* x_imaginary, float* y_real, float* y_imaginary,
+                                    const size_t rows, const size_t columns) {
+    kernels_float().complex_matvec(matrix_real, matrix_imaginary, stride, x_real, x_imaginary, y_real, y_imaginary, rows, columns);
+}
+
+unsigned Kernels<float>::lane_solve(const float* system, const size_t n, float* solution, float* pivots) {
+    return kernels_float().lane_solve(system, n, solution, pivots);
+}
+
+unsigned Kernels<float>::complex_lane_solve(const float* system_real, const float* system_imaginary, const size_t n,
+                                            float* solution_real, float* solution_imaginary, float* pivots) {
+    return kernels_float().complex_lane_solve(system_real, system_imaginary, n, solution_real, solution_imaginary, pivots);
+}
+
+void Kernels<float>::lane_residual(const float* system, const size_t n, const float* solution, float* error) {
+    kernels_float().lane_residual(system, n, solution, error);
+}
+
+void Kernels<float>::complex_lane_residual(const float* system_real, const float* system_imaginary, const size_t n,
+                                           const float* solution_real, const float* solution_imaginary, float* error_real, float* error_imaginary) {
+    kernels_float().complex_lane_residual(system_real, system_imaginary, n, solution_real, solution_imaginary, error_real, error_imaginary);
+}
+
+const char* Kernels<float>::isa() {
+    return isa_name(::isa());
+}
+
+size_t Kernels<float>::variants() {
+    return static_cast<size_t>(::isa()) + 1;
+}
+
+KernelTable<float> Kernels<float>::variant(const size_t i, const char*& name) {
+    name = isa_name(static_cast<Isa>(i));
+    return table_float(static_cast<Isa>(i));
+}
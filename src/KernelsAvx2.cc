@@ -0,0 +1,72 @@
+/* jednostka kompilowana z -mavx2 -mfma, wolana tylko gdy procesor obsluguje te instrukcje */
+
+#include <immintrin.h>
+
+#include "../inc/SimdKernels.hh"
+
+struct Avx2Double {
+    using scalar = double;
+    using vector = __m256d;
+    using mask = __m256d;
+    static constexpr size_t width = 4;
+
+    static vector zero() { return _mm256_setzero_pd(); }
+    static vector load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, vector v) { _mm256_storeu_pd(p, v); }
+    static vector broadcast(double a) { return _mm256_set1_pd(a); }
+    static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+    static vector sub(vector a, vector b) { return _mm256_sub_pd(a, b); }
+    static vector mul(vector a, vector b) { return _mm256_mul_pd(a, b); }
+    static vector div(vector a, vector b) { return _mm256_div_pd(a, b); }
+    static vector fma(vector a, vector b, vector c) { return _mm256_fmadd_pd(a, b, c); }
+    static vector fnma(vector a, vector b, vector c) { return _mm256_fnmadd_pd(a, b, c); }
+
+    static double reduce(vector v) {
+        const __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    }
+
+    static vector abs(vector a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static mask greater(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static mask equal(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static vector select(mask m, vector a, vector b) { return _mm256_blendv_pd(b, a, m); }
+    static unsigned bits(mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+};
+
+struct Avx2Float {
+    using scalar = float;
+    using vector = __m256;
+    using mask = __m256;
+    static constexpr size_t width = 8;
+
+    static vector zero() { return _mm256_setzero_ps(); }
+    static vector load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, vector v) { _mm256_storeu_ps(p, v); }
+    static vector broadcast(float a) { return _mm256_set1_ps(a); }
+    static vector add(vector a, vector b) { return _mm256_add_ps(a, b); }
+    static vector sub(vector a, vector b) { return _mm256_sub_ps(a, b); }
+    static vector mul(vector a, vector b) { return _mm256_mul_ps(a, b); }
+    static vector div(vector a, vector b) { return _mm256_div_ps(a, b); }
+    static vector fma(vector a, vector b, vector c) { return _mm256_fmadd_ps(a, b, c); }
+    static vector fnma(vector a, vector b, vector c) { return _mm256_fnmadd_ps(a, b, c); }
+
+    static float reduce(vector v) {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        return _mm_cvtss_f32(_mm_add_ss(sum, _mm_movehdup_ps(sum)));
+    }
+
+    static vector abs(vector a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static mask greater(vector a, vector b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static mask equal(vector a, vector b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static vector select(mask m, vector a, vector b) { return _mm256_blendv_ps(b, a, m); }
+    static unsigned bits(mask m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+};
+
+KernelTable<double> avx2_kernels_double() {
+    return SimdKernels<Avx2Double>::table();
+}
+
+KernelTable<float> avx2_kernels_float() {
+    return SimdKernels<Avx2Float>::table();
+}
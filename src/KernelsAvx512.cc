@@ -0,0 +1,61 @@
+/* jednostka kompilowana z -mavx512f, wolana tylko gdy procesor obsluguje te instrukcje */
+
+#include <immintrin.h>
+
+#include "../inc/SimdKernels.hh"
+
+struct Avx512Double {
+    using scalar = double;
+    using vector = __m512d;
+    using mask = __mmask8;
+    static constexpr size_t width = 8;
+
+    static vector zero() { return _mm512_setzero_pd(); }
+    static vector load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, vector v) { _mm512_storeu_pd(p, v); }
+    static vector broadcast(double a) { return _mm512_set1_pd(a); }
+    static vector add(vector a, vector b) { return _mm512_add_pd(a, b); }
+    static vector sub(vector a, vector b) { return _mm512_sub_pd(a, b); }
+    static vector mul(vector a, vector b) { return _mm512_mul_pd(a, b); }
+    static vector div(vector a, vector b) { return _mm512_div_pd(a, b); }
+    static vector fma(vector a, vector b, vector c) { return _mm512_fmadd_pd(a, b, c); }
+    static vector fnma(vector a, vector b, vector c) { return _mm512_fnmadd_pd(a, b, c); }
+    static double reduce(vector v) { return _mm512_reduce_add_pd(v); }
+    static vector abs(vector a) { return _mm512_abs_pd(a); }
+    static mask greater(vector a, vector b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static mask equal(vector a, vector b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static vector select(mask m, vector a, vector b) { return _mm512_mask_blend_pd(m, b, a); }
+    static unsigned bits(mask m) { return m; }
+};
+
+struct Avx512Float {
+    using scalar = float;
+    using vector = __m512;
+    using mask = __mmask16;
+    static constexpr size_t width = 16;
+
+    static vector zero() { return _mm512_setzero_ps(); }
+    static vector load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, vector v) { _mm512_storeu_ps(p, v); }
+    static vector broadcast(float a) { return _mm512_set1_ps(a); }
+    static vector add(vector a, vector b) { return _mm512_add_ps(a, b); }
+    static vector sub(vector a, vector b) { return _mm512_sub_ps(a, b); }
+    static vector mul(vector a, vector b) { return _mm512_mul_ps(a, b); }
+    static vector div(vector a, vector b) { return _mm512_div_ps(a, b); }
+    static vector fma(vector a, vector b, vector c) { return _mm512_fmadd_ps(a, b, c); }
+    static vector fnma(vector a, vector b, vector c) { return _mm512_fnmadd_ps(a, b, c); }
+    static float reduce(vector v) { return _mm512_reduce_add_ps(v); }
+    static vector abs(vector a) { return _mm512_abs_ps(a); }
+    static mask greater(vector a, vector b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static mask equal(vector a, vector b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static vector select(mask m, vector a, vector b) { return _mm512_mask_blend_ps(m, b, a); }
+    static unsigned bits(mask m) { return m; }
+};
+
+KernelTable<double> avx512_kernels_double() {
+    return SimdKernels<Avx512Double>::table();
+}
+
+KernelTable<float> avx512_kernels_float() {
+    return SimdKernels<Avx512Float>::table();
+}
@@ -0,0 +1,66 @@
+#include "../inc/MappedFile.hh"
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) {
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        throw std::runtime_error("Cannot open file " + path);
+
+    struct stat status{};
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw std::runtime_error("Cannot open file " + path);
+    }
+    length = static_cast<size_t>(status.st_size);
+
+    /* mmap nie przyjmuje mapowan o dlugosci 0, pusty plik to pusty bufor */
+    if (length > 0) {
+        void* result = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (result == MAP_FAILED) {
+            close(descriptor);
+            throw std::runtime_error("Cannot map file " + path);
+        }
+        mapping = static_cast<const char*>(result);
+        madvise(result, length, MADV_SEQUENTIAL);
+    }
+
+    /* mapowanie pozostaje wazne po zamknieciu deskryptora */
+    close(descriptor);
+}
+
+MappedFile::MappedFile(MappedFile&& file) noexcept
+        : mapping(file.mapping), length(file.length), released(file.released) {
+    file.mapping = nullptr;
+    file.length = 0;
+    file.released = 0;
+}
+
+MappedFile::~MappedFile() {
+    if (mapping)
+        munmap(const_cast<char*>(mapping), length);
+}
+
+const char* MappedFile::data() const {
+    return mapping;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+void MappedFile::release(const size_t offset) {
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    const size_t end = offset / page * page;
+    if (!mapping || end <= released)
+        return;
+
+    madvise(const_cast<char*>(mapping) + released, end - released, MADV_DONTNEED);
+    released = end;
+}
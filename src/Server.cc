@@ -0,0 +1,385 @@
+#include "../inc/Server.hh"
+
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../inc/Arena.hh"
+#include "../inc/Complex.hh"
+#include "../inc/DynamicMatrix.hh"
+#include "../inc/DynamicVector.hh"
+#include "../inc/LUDecomposition.hh"
+
+/**
+ * Buforowane czytanie ramek z deskryptora
+ */
+class FrameReader {
+public:
+    /**
+     * Tworzy pusty bufor
+     * @param descriptor
+     */
+    explicit FrameReader(const int descriptor) : descriptor(descriptor), buffer(new char[capacity]) {}
+
+    /**
+     * Czyta dokladnie count bajtow
+     * @param target
+     * @param count
+     * @return false przy koncu wejscia lub bledzie przed przeczytaniem wszystkich bajtow
+     */
+    bool read(void* target, size_t count) {
+        char* cursor = static_cast<char*>(target);
+        while (count > 0) {
+            if (begin == end && !fill())
+                return false;
+            const size_t part = count < end - begin ? count : end - begin;
+            std::memcpy(cursor, buffer.get() + begin, part);
+            begin += part;
+            cursor += part;
+            count -= part;
+        }
+        return true;
+    }
+
+    /**
+     * Pomija count bajtow
+     * @param count
+     * @return false przy koncu wejscia lub bledzie
+     */
+    bool skip(size_t count) {
+        while (count > 0) {
+            if (begin == end && !fill())
+                return false;
+            const size_t part = count < end - begin ? count : end - begin;
+            begin += part;
+            count -= part;
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t capacity = 1 << 16; /** Rozmiar bufora */
+
+    int descriptor; /** Deskryptor */
+    std::unique_ptr<char[]> buffer; /** Bufor */
+    size_t begin = 0; /** Poczatek nieprzeczytanych bajtow */
+    size_t end = 0; /** Koniec nieprzeczytanych bajtow */
+
+    /**
+     * Wczytuje do pustego bufora tyle, ile jest dostepne
+     * @return false przy koncu wejscia lub bledzie
+     */
+    bool fill() {
+        for (;;) {
+            const ssize_t result = ::read(descriptor, buffer.get(), capacity);
+            if (result > 0) {
+                begin = 0;
+                end = static_cast<size_t>(result);
+                return true;
+            }
+            if (result == 0 || errno != EINTR)
+                return false;
+        }
+    }
+};
+
+/**
+ * Macierz zadania i jej rozklad, wspolne dla zadan, ktore go ponownie uzywaja; rozklad liczy pierwsze
+ * zadanie, ktore go potrzebuje, a pozostale na nie czekaja
+ * @tparam T
+ */
+template <class T>
+struct ServerWorkspace {
+    size_t size; /** Rozmiar macierzy */
+    DynamicMatrix<T> matrix; /** Macierz, zwalniana po rozkladzie */
+    std::once_flag factored; /** Czy rozklad jest policzony */
+    std::unique_ptr<DynamicLUDecomposition<T>> decomposition; /** Rozklad, pusty dla macierzy osobliwej */
+
+    /**
+     * Tworzy macierz zerowa
+     * @param size
+     */
+    explicit ServerWorkspace(const size_t size) : size(size), matrix(size, size) {}
+
+    /**
+     * Zwraca rozklad macierzy, liczac go przy pierwszym wywolaniu
+     * @return rozklad lub nullptr dla macierzy osobliwej
+     */
+    const DynamicLUDecomposition<T>* factor() {
+        std::call_once(factored, [this] {
+            /* rozklad zyje dluzej niz zadanie, wiec nie moze trafic do areny watku */
+            const AllocationScope scope(nullptr);
+            try {
+                decomposition = std::make_unique<DynamicLUDecomposition<T>>(matrix);
+            } catch (const std::runtime_error&) {}
+            matrix = DynamicMatrix<T>();
+        });
+        return decomposition.get();
+    }
+};
+
+/**
+ * Zadanie czekajace na rozwiazanie
+ * @tparam T
+ */
+template <class T>
+struct ServerJob {
+    uint64_t id; /** Identyfikator zadania */
+    size_t count; /** Liczba wektorow b */
+    std::shared_ptr<ServerWorkspace<T>> workspace; /** Macierz i rozklad */
+    std::vector<T> vectors; /** Wektory b zapisane kolejno */
+};
+
+/**
+ * Stan jednego polaczenia
+ */
+struct ServerConnection {
+    int output; /** Deskryptor odpowiedzi */
+    std::mutex writing; /** Chroni zapis odpowiedzi */
+    bool broken = false; /** Czy zapis sie nie powiodl (odpowiedzi sa wtedy pomijane) */
+
+    std::mutex mutex; /** Chroni pending */
+    std::condition_variable finished; /** Budzi czytajacego po zakonczeniu zadania */
+    size_t pending = 0; /** Liczba zadan w toku */
+    TaskGroup group; /** Zadania polaczenia */
+
+    std::shared_ptr<ServerWorkspace<double>> real; /** Ostatnia macierz rzeczywista */
+    std::shared_ptr<ServerWorkspace<Complex<double>>> complex; /** Ostatnia macierz zespolona */
+
+    /**
+     * Tworzy polaczenie
+     * @param output
+     */
+    explicit ServerConnection(const int output) : output(output) {}
+
+    /**
+     * Zwraca ostatnia macierz o skalarach T
+     * @return referencja na wskaznik
+     */
+    template <class T>
+    std::shared_ptr<ServerWorkspace<T>>& workspace() {
+        if constexpr (std::is_same<T, double>::value)
+            return real;
+        else
+            return complex;
+    }
+
+    /**
+     * Wysyla ramke odpowiedzi jednym zapisem
+     * @param frame naglowek i dane
+     * @param length
+     */
+    void respond(const char* frame, size_t length) {
+        const std::lock_guard<std::mutex> lock(writing);
+        while (!broken && length > 0) {
+            const ssize_t result = ::write(output, frame, length);
+            if (result > 0) {
+                frame += result;
+                length -= static_cast<size_t>(result);
+            } else if (errno != EINTR) {
+                broken = true;
+            }
+        }
+    }
+
+    /**
+     * Wysyla odpowiedz bez danych
+     * @param id
+     * @param status
+     * @param size
+     */
+    void respond(const uint64_t id, const ResponseStatus status, const size_t size) {
+        ResponseHeader header{};
+        std::memcpy(header.magic, response_magic, sizeof(header.magic));
+        header.id = id;
+        header.status = static_cast<uint8_t>(status);
+        header.size = static_cast<uint32_t>(size);
+        respond(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+};
+
+/**
+ * Rozwiazuje zadanie i wysyla odpowiedz; pamiec robocza (wektory, bufor odpowiedzi) pochodzi z areny
+ * watku, ktora po pierwszych zadaniach nie alokuje juz ze sterty
+ * @tparam T
+ * @param connection
+ * @param job
+ */
+template <class T>
+static void solve(ServerConnection& connection, ServerJob<T>& job) {
+    static thread_local Arena arena(1 << 16);
+
+    ServerWorkspace<T>& workspace = *job.workspace;
+    const size_t n = workspace.size;
+    try {
+        const DynamicLUDecomposition<T>* const decomposition = workspace.factor();
+        if (decomposition == nullptr) {
+            connection.respond(job.id, ResponseStatus::singular, n);
+        } else {
+            const AllocationScope scope(&arena);
+            const size_t length = job.count * n * sizeof(T);
+            std::vector<char, AlignedAllocator<char>> frame(sizeof(ResponseHeader) + length);
+
+            ResponseHeader header{};
+            std::memcpy(header.magic, response_magic, sizeof(header.magic));
+            header.length = static_cast<uint32_t>(length);
+            header.id = job.id;
+            header.status = static_cast<uint8_t>(ResponseStatus::solved);
+            header.size = static_cast<uint32_t>(n);
+            header.count = static_cast<uint32_t>(job.count);
+            std::memcpy(frame.data(), &header, sizeof(header));
+
+            DynamicVector<T> vector(n);
+            for (size_t k = 0; k < job.count; k++) {
+                std::memcpy(vector.data(), job.vectors.data() + k * n, n * sizeof(T));
+                const DynamicVector<T> solution = decomposition->solve(vector);
+                std::memcpy(frame.data() + sizeof(header) + k * n * sizeof(T), solution.data(), n * sizeof(T));
+            }
+            connection.respond(frame.data(), frame.size());
+        }
+    } catch (const std::exception&) {
+        connection.respond(job.id, ResponseStatus::invalid, n);
+    }
+    arena.reset();
+}
+
+/**
+ * Czyta dane zadania i zleca jego rozwiazanie puli; bledne zadanie dostaje odpowiedz od razu
+ * @tparam T
+ * @param pool
+ * @param connection
+ * @param request
+ * @param reader
+ * @return false jesli wejscie skonczylo sie przed koncem ramki
+ */
+template <class T>
+static bool dispatch(ThreadPool& pool, ServerConnection& connection, const RequestHeader& request, FrameReader& reader) {
+    static constexpr size_t size_limit = 1 << 14;
+
+    const size_t n = request.size, count = request.count;
+    const bool reuse = (request.flags & request_reuse) != 0;
+    std::shared_ptr<ServerWorkspace<T>>& last = connection.workspace<T>();
+
+    /* rozmiar ograniczony, zeby dlugosc liczyla sie bez przepelnienia; dane sprawdzane sa z naglowkiem */
+    if (n == 0 || n > size_limit || count == 0 || count > request_length_limit
+        || (static_cast<uint64_t>(reuse ? 0 : n * n) + static_cast<uint64_t>(count) * n) * sizeof(T) != request.length
+        || (reuse && (!last || last->size != n))) {
+        connection.respond(request.id, ResponseStatus::invalid, n);
+        return reader.skip(request.length);
+    }
+
+    if (!reuse) {
+        last = std::make_shared<ServerWorkspace<T>>(n);
+        if (!reader.read(last->matrix.data(), n * n * sizeof(T)))
+            return false;
+    }
+
+    const std::shared_ptr<ServerJob<T>> job = std::make_shared<ServerJob<T>>();
+    job->id = request.id;
+    job->count = count;
+    job->workspace = last;
+    job->vectors.resize(count * n);
+    if (!reader.read(job->vectors.data(), count * n * sizeof(T)))
+        return false;
+
+    /* zadania czytane sa dalej, gdy poprzednie sie rozwiazuja, ale najwyzej pending_limit naraz */
+    {
+        std::unique_lock<std::mutex> lock(connection.mutex);
+        connection.finished.wait(lock, [&] {
+            return connection.pending < Server::pending_limit;
+        });
+        connection.pending++;
+    }
+
+    pool.run(connection.group, [&connection, job] {
+        solve(connection, *job);
+        const std::lock_guard<std::mutex> lock(connection.mutex);
+        connection.pending--;
+        connection.finished.notify_one();
+    });
+    return true;
+}
+
+Server::Server(const size_t threads) : pool(threads) {
+    /* zapis do zamknietego gniazda lub potoku ma konczyc polaczenie, a nie caly serwer */
+    std::signal(SIGPIPE, SIG_IGN);
+}
+
+void Server::serve(const int input, const int output) {
+    ServerConnection connection(output);
+    FrameReader reader(input);
+    RequestHeader request{};
+
+    while (reader.read(&request, sizeof(request))) {
+        /* po blednej sygnaturze lub dlugosci nie wiadomo, gdzie zaczyna sie kolejna ramka */
+        if (std::memcmp(request.magic, request_magic, sizeof(request.magic)) != 0
+            || request.length > request_length_limit) {
+            connection.respond(request.id, ResponseStatus::invalid, 0);
+            break;
+        }
+
+        bool complete;
+        switch (request.field) {
+            case 'r' :
+                complete = dispatch<double>(pool, connection, request, reader);
+                break;
+            case 'z' :
+                complete = dispatch<Complex<double>>(pool, connection, request, reader);
+                break;
+            default:
+                connection.respond(request.id, ResponseStatus::invalid, request.size);
+                complete = reader.skip(request.length);
+        }
+        if (!complete)
+            break;
+    }
+
+    pool.wait(connection.group);
+}
+
+void Server::listen(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Socket path too long");
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+        throw std::runtime_error("Cannot create socket");
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener, SOMAXCONN) != 0) {
+        close(listener);
+        throw std::runtime_error("Cannot listen on " + path);
+    }
+
+    for (;;) {
+        const int client = accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            close(listener);
+            throw std::runtime_error("Cannot accept connection");
+        }
+
+        /* polaczenia koncza sie niezaleznie od siebie, a serwer dziala do zakonczenia procesu */
+        std::thread([this, client] {
+            try {
+                serve(client, client);
+            } catch (const std::exception&) {}
+            close(client);
+        }).detach();
+    }
+}
@@ -0,0 +1,133 @@
+#include "../inc/ThreadPool.hh"
+
+#include <chrono>
+
+/* pula, do ktorej nalezy biezacy watek, i jego indeks w tej puli */
+static thread_local const ThreadPool* current_pool = nullptr;
+static thread_local size_t current_index = 0;
+
+ThreadPool::ThreadPool(size_t workers) {
+    if (workers == 0)
+        workers = std::thread::hardware_concurrency();
+    if (workers == 0)
+        workers = 1;
+
+    for (size_t i = 0; i < workers; i++)
+        queues.emplace_back(new Queue());
+
+    for (size_t i = 0; i < workers; i++)
+        threads.emplace_back([this, i] { work(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+size_t ThreadPool::size() const {
+    /* kolejki sa gotowe przed startem watkow, a wektor watkow rosnie, gdy pierwsze juz pracuja */
+    return queues.size();
+}
+
+size_t ThreadPool::current() const {
+    return current_pool == this ? current_index : size();
+}
+
+void ThreadPool::run(TaskGroup& group, std::function<void()> task) {
+    group.pending++;
+
+    size_t index = current();
+    if (index == size())
+        index = next_queue++ % size();
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(Task{std::move(task), &group});
+    }
+    queued++;
+
+    /* pusta sekcja krytyczna: watek sprawdzajacy queued pod tym zamkiem nie przegapi powiadomienia */
+    { std::lock_guard<std::mutex> lock(sleep_mutex); }
+    wake.notify_one();
+}
+
+bool ThreadPool::run_one(const size_t index) {
+    Task task;
+    bool found = false;
+
+    for (size_t i = 0; i < size() && !found; i++) {
+        Queue& queue = *queues[(index + i) % size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        found = true;
+    }
+
+    if (!found)
+        return false;
+    queued--;
+
+    try {
+        task.function();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(task.group->mutex);
+        if (!task.group->exception)
+            task.group->exception = std::current_exception();
+    }
+
+    if (--task.group->pending == 0) {
+        { std::lock_guard<std::mutex> lock(sleep_mutex); }
+        finished.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::work(const size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    while (true) {
+        if (run_one(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0)
+            return;
+    }
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    const size_t index = current() % size();
+
+    while (group.pending > 0) {
+        if (run_one(index))
+            continue;
+
+        /* zadania grupy wykonuja sie na innych watkach; krotki limit czasu chroni przed sytuacja,
+         * w ktorej wszystkie watki czekaja wewnatrz zadan, a w kolejkach sa zadania do wykonania */
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        finished.wait_for(lock, std::chrono::milliseconds(1), [&group] { return group.pending == 0; });
+    }
+
+    std::lock_guard<std::mutex> lock(group.mutex);
+    if (group.exception) {
+        std::exception_ptr exception = group.exception;
+        group.exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
@@ -0,0 +1,115 @@
+#include "../inc/Writer.hh"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <system_error>
+
+Writer::Writer(std::ostream& out, const int precision, const size_t capacity)
+        : out(out), buffer(new char[capacity > 0 ? capacity : 1]), capacity(capacity > 0 ? capacity : 1),
+          digits(precision) {}
+
+Writer::~Writer() {
+    flush();
+}
+
+int Writer::precision() const {
+    return digits;
+}
+
+void Writer::precision(const int digits) {
+    this->digits = digits;
+}
+
+size_t Writer::written() const {
+    return flushed + length;
+}
+
+void Writer::flush() {
+    out.write(buffer.get(), static_cast<std::streamsize>(length));
+    flushed += length;
+    length = 0;
+}
+
+void Writer::append(const char* text, size_t count) {
+    while (count > capacity - length) {
+        const size_t part = capacity - length;
+        std::memcpy(buffer.get() + length, text, part);
+        length = capacity;
+        text += part;
+        count -= part;
+        flush();
+    }
+    std::memcpy(buffer.get() + length, text, count);
+    length += count;
+}
+
+Writer& Writer::operator<<(const char character) {
+    if (length == capacity)
+        flush();
+    buffer[length++] = character;
+    return *this;
+}
+
+Writer& Writer::operator<<(const char* text) {
+    append(text, std::strlen(text));
+    return *this;
+}
+
+Writer& Writer::operator<<(const std::string& text) {
+    append(text.data(), text.size());
+    return *this;
+}
+
+Writer& Writer::operator<<(const size_t value) {
+    char text[32];
+    const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    append(text, result.ptr - text);
+    return *this;
+}
+
+Writer& Writer::operator<<(const double value) {
+    number(value, false);
+    return *this;
+}
+
+Writer& Writer::operator<<(const float value) {
+    number(value, false);
+    return *this;
+}
+
+template <class T>
+void Writer::number(const T value, const bool sign) {
+    /* std::showpos dopisuje + przed kazda liczba bez bitu znaku, takze przed 0 i nan */
+    if (sign && !std::signbit(value))
+        *this << '+';
+
+    /* to_chars w formacie general z precyzja p daje ten sam tekst co printf("%.*g"), czyli operator<< */
+    for (;;) {
+        char* first = buffer.get() + length;
+        char* last = buffer.get() + capacity;
+        const std::to_chars_result result = digits == shortest
+                                            ? std::to_chars(first, last, value)
+                                            : std::to_chars(first, last, value, std::chars_format::general, digits);
+        if (result.ec == std::errc()) {
+            length = result.ptr - buffer.get();
+            return;
+        }
+
+        /* liczba nie miesci sie w buforze: po oproznieniu zapisywana jest przez bufor lokalny, bo bufor
+         * o malej pojemnosci moze nie pomiescic jej nawet pusty (%g dla double ma mniej niz 800 znakow) */
+        if (length == 0) {
+            char scratch[1024];
+            const std::to_chars_result local = digits == shortest
+                                               ? std::to_chars(scratch, scratch + sizeof(scratch), value)
+                                               : std::to_chars(scratch, scratch + sizeof(scratch), value,
+                                                               std::chars_format::general, digits);
+            append(scratch, local.ptr - scratch);
+            return;
+        }
+        flush();
+    }
+}
+
+template void Writer::number<double>(double value, bool sign);
+template void Writer::number<float>(float value, bool sign);
@@ -0,0 +1,330 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../inc/Arena.hh"
+#include "../inc/Benchmark.hh"
+#include "../inc/BatchSolver.hh"
+#include "../inc/LinearEquation.hh"
+#include "../inc/Parser.hh"
+#include "../inc/Writer.hh"
+
+/* pomiary operacji programu zad3 dla skalarow double i Complex<double>: wyznacznik, rozwiazanie ukladu,
+ * iloczyn skalarny, mnozenie macierzy przez wektor, arytmetyka zespolona oraz wczytywanie i wypisywanie
+ * ukladow w formacie .dat; dane losowane z ustalonym ziarnem, wiec kolejne uruchomienia mierza to samo */
+
+/**
+ * Losowanie skalarow T z przedzialu [-1, 1] (obie czesci liczby zespolonej)
+ * @tparam T
+ */
+template <class T>
+struct Random {
+    /**
+     * Losuje skalar
+     * @param generator
+     * @return skalar
+     */
+    static T scalar(std::mt19937_64& generator) {
+        std::uniform_real_distribution<typename Scalar<T>::real_type> distribution(-1, 1);
+        if constexpr (Scalar<T>::complex) {
+            const auto real = distribution(generator);
+            return T(real, distribution(generator));
+        } else {
+            return distribution(generator);
+        }
+    }
+
+    /**
+     * Losuje wektor
+     * @param generator
+     * @param n
+     * @return wektor
+     */
+    static DynamicVector<T> vector(std::mt19937_64& generator, const size_t n) {
+        DynamicVector<T> result(n);
+        for (size_t i = 0; i < n; i++)
+            result[i] = scalar(generator);
+        return result;
+    }
+
+    /**
+     * Losuje macierz kwadratowa
+     * @param generator
+     * @param n
+     * @return macierz
+     */
+    static DynamicMatrix<T> matrix(std::mt19937_64& generator, const size_t n) {
+        DynamicMatrix<T> result(n, n);
+        for (size_t x = 0; x < n; x++)
+            for (size_t y = 0; y < n; y++)
+                result[x][y] = scalar(generator);
+        return result;
+    }
+
+    /**
+     * Losuje uklad rownan
+     * @param generator
+     * @param n
+     * @return uklad
+     */
+    static DynamicLinearEquation<T> equation(std::mt19937_64& generator, const size_t n) {
+        DynamicLinearEquation<T> result;
+        result.factor_matrix = matrix(generator, n);
+        result.result_vector = vector(generator, n);
+        return result;
+    }
+};
+
+/**
+ * Mierzy wyznacznik i rozwiazanie ukladu o rozmiarze ustalonym w czasie kompilacji
+ * @tparam T
+ * @tparam size
+ * @param benchmark
+ * @param scalar nazwa typu skalara
+ * @param generator
+ */
+template <class T, size_t size>
+void bench_fixed(Benchmark& benchmark, const std::string& scalar, std::mt19937_64& generator) {
+    LinearEquation<T, size> equation;
+    for (size_t x = 0; x < size; x++) {
+        for (size_t y = 0; y < size; y++)
+            equation.factor_matrix[x][y] = Random<T>::scalar(generator);
+        equation.result_vector[x] = Random<T>::scalar(generator);
+    }
+
+    benchmark.run("det_fixed", scalar, size, [&] {
+        keep(equation.factor_matrix.det());
+    });
+    benchmark.run("solve_fixed", scalar, size, [&] {
+        equation.solve();
+        keep(equation.unknown_vector);
+    });
+}
+
+/**
+ * Wypisuje uklad w formacie .dat jak zad3 --convert
+ * @tparam T
+ * @param field
+ * @param equation
+ * @return tekst
+ */
+template <class T>
+std::string format_equation(const char field, const DynamicLinearEquation<T>& equation) {
+    std::ostringstream out;
+    out << field << '\n' << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    for (size_t y = 0; y < equation.size(); y++) {
+        for (size_t x = 0; x < equation.size(); x++)
+            out << (x > 0 ? " " : "") << equation.factor_matrix[x][y];
+        out << '\n';
+    }
+    out << equation.result_vector << '\n';
+    return out.str();
+}
+
+/**
+ * Mierzy wszystkie operacje dla skalarow T
+ * @tparam T
+ * @param benchmark
+ * @param scalar nazwa typu skalara
+ * @param field znak ciala liczb w formacie .dat
+ */
+template <class T>
+void bench_scalar(Benchmark& benchmark, const std::string& scalar, const char field) {
+    std::mt19937_64 generator(2020);
+
+    bench_fixed<T, 2>(benchmark, scalar, generator);
+    bench_fixed<T, 3>(benchmark, scalar, generator);
+    bench_fixed<T, 4>(benchmark, scalar, generator);
+    bench_fixed<T, 5>(benchmark, scalar, generator);
+    bench_fixed<T, 8>(benchmark, scalar, generator);
+
+    for (const size_t n : {16, 64, 256}) {
+        const DynamicMatrix<T> matrix = Random<T>::matrix(generator, n);
+        benchmark.run("det", scalar, n, [&] {
+            keep(matrix.det());
+        });
+    }
+
+    for (const size_t n : {5, 50, 200, 500}) {
+        DynamicLinearEquation<T> equation = Random<T>::equation(generator, n);
+        benchmark.run("solve", scalar, n, [&] {
+            equation.solve();
+            keep(equation.unknown_vector);
+        });
+    }
+
+    /* to samo z pamiecia robocza z areny zwalnianej po kazdym ukladzie; kolumna alokacje pokazuje roznice */
+    for (const size_t n : {5, 50, 200}) {
+        DynamicLinearEquation<T> equation = Random<T>::equation(generator, n);
+        Arena arena;
+        benchmark.run("solve_arena", scalar, n, [&] {
+            {
+                const AllocationScope scope(&arena);
+                equation.solve();
+                keep(equation.unknown_vector);
+            }
+            arena.reset();
+        });
+    }
+
+    /* strumien 1024 malych ukladow: kazdy osobno metoda solve() i blokami po kilka naraz (solve_lanes) */
+    for (const size_t n : {2, 5, 8}) {
+        std::vector<DynamicLinearEquation<T>> equations;
+        std::vector<DynamicLinearEquation<T>*> pointers;
+        for (size_t i = 0; i < 1024; i++)
+            equations.push_back(Random<T>::equation(generator, n));
+        for (DynamicLinearEquation<T>& equation : equations)
+            pointers.push_back(&equation);
+
+        benchmark.run("solve_stream", scalar, n, [&] {
+            for (DynamicLinearEquation<T>& equation : equations)
+                equation.solve();
+            keep(equations);
+        });
+        benchmark.run("solve_lanes", scalar, n, [&] {
+            solve_lanes(pointers.data(), pointers.size());
+            keep(equations);
+        });
+    }
+
+    for (const size_t n : {1000, 100000}) {
+        const DynamicVector<T> a = Random<T>::vector(generator, n), b = Random<T>::vector(generator, n);
+        benchmark.run("dot", scalar, n, [&] {
+            keep(a.dot(b));
+        });
+    }
+
+    for (const size_t n : {100, 1000}) {
+        const DynamicMatrix<T> matrix = Random<T>::matrix(generator, n);
+        const DynamicVector<T> vector = Random<T>::vector(generator, n);
+        DynamicVector<T> result(n);
+        benchmark.run("matvec", scalar, n, [&] {
+            result = matrix * vector;
+            keep(result);
+        });
+    }
+
+    for (const size_t n : {5, 100, 500}) {
+        DynamicLinearEquation<T> equation = Random<T>::equation(generator, n);
+        const std::string text = format_equation(field, equation);
+
+        benchmark.run("parse", scalar, n, [&] {
+            Parser parser(text);
+            parser.field();
+            DynamicLinearEquation<T> parsed;
+            parser.equation(parsed);
+            keep(parsed);
+        });
+
+        /* wypisywane jak rozwiazanie w zad3: wektor niewiadomych i wektor bledu */
+        equation.solve();
+        benchmark.run("print", scalar, n, [&] {
+            std::ostringstream out;
+            out << equation.unknown_vector << '\n' << equation.error_vector << '\n';
+            keep(out);
+        });
+        benchmark.run("print_writer", scalar, n, [&] {
+            std::ostringstream out;
+            {
+                Writer writer(out);
+                writer << equation.unknown_vector << '\n' << equation.error_vector << '\n';
+            }
+            keep(out);
+        });
+    }
+}
+
+/**
+ * Mierzy arytmetyke liczb zespolonych na tablicach skalarow
+ * @param benchmark
+ */
+void bench_complex(Benchmark& benchmark) {
+    static const size_t n = 1024;
+
+    std::mt19937_64 generator(2020);
+    std::vector<Complex<double>> a(n), b(n), c(n);
+    for (size_t i = 0; i < n; i++) {
+        a[i] = Random<Complex<double>>::scalar(generator);
+        b[i] = Random<Complex<double>>::scalar(generator);
+    }
+
+    benchmark.run("complex_add", "complex", n, [&] {
+        for (size_t i = 0; i < n; i++)
+            c[i] = a[i] + b[i];
+        keep(c);
+    });
+    benchmark.run("complex_multiply", "complex", n, [&] {
+        for (size_t i = 0; i < n; i++)
+            c[i] = a[i] * b[i];
+        keep(c);
+    });
+    benchmark.run("complex_divide", "complex", n, [&] {
+        for (size_t i = 0; i < n; i++)
+            c[i] = a[i] / b[i];
+        keep(c);
+    });
+}
+
+/**
+ * Wypisuje sposob uzycia
+ * @param program
+ * @return kod wyjscia
+ */
+int usage(const char* program) {
+    std::cerr << "Uzycie: " << program << " [--filter napis] [--samples n] [--warmup n] [--sample-time ms]"
+              << " [--json plik]" << std::endl;
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    Benchmark benchmark;
+    std::string json;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string option = argv[i];
+        if (i + 1 == argc)
+            return usage(argv[0]);
+
+        const std::string value = argv[++i];
+        if (option == "--filter")
+            benchmark.filter = value;
+        else if (option == "--samples")
+            benchmark.samples = std::stoul(value);
+        else if (option == "--warmup")
+            benchmark.warmup = std::stoul(value);
+        else if (option == "--sample-time")
+            benchmark.sample_time = std::chrono::milliseconds(std::stoul(value));
+        else if (option == "--json")
+            json = value;
+        else
+            return usage(argv[0]);
+    }
+    if (benchmark.samples == 0)
+        return usage(argv[0]);
+
+    bench_scalar<double>(benchmark, "double", 'r');
+    bench_scalar<Complex<double>>(benchmark, "complex", 'z');
+    bench_complex(benchmark);
+
+    /* z --json - na standardowe wyjscie trafia tylko JSON */
+    if (json == "-") {
+        benchmark.write_json(std::cout);
+        return 0;
+    }
+
+    benchmark.write_table(std::cout);
+    if (!json.empty()) {
+        std::ofstream out(json);
+        benchmark.write_json(out);
+        if (!out) {
+            std::cerr << "Nie mozna zapisac pliku " << json << std::endl;
+            return 1;
+        }
+    }
+}
@@ -1,53 +1,468 @@
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../inc/Arena.hh"
 #include "../inc/LinearEquation.hh"
+#include "../inc/Parser.hh"
+#include "../inc/MappedFile.hh"
+#include "../inc/BatchSolver.hh"
+#include "../inc/BinaryFormat.hh"
+#include "../inc/Instrumentation.hh"
+#include "../inc/Server.hh"
+#include "../inc/Writer.hh"
+
+/**
+ * Uklad rownan wczytany razem ze znakiem ciala liczb
+ */
+struct System {
+    char field = 0; /** Znak ciala liczb (r lub z) */
+    DynamicLinearEquation<double> real; /** Uklad dla field == 'r' */
+    DynamicLinearEquation<Complex<double>> complex; /** Uklad dla field == 'z' */
+    bool singular = false; /** Czy rozwiazanie nie powiodlo sie (macierz osobliwa) */
+
+    /**
+     * Wczytuje znak ciala i uklad
+     * @param parser
+     * @return false jesli cialo liczb nie zostalo rozpoznane
+     */
+    bool read(Parser& parser) {
+        field = parser.field();
+        switch (field) {
+            case 'r' : {
+                real = DynamicLinearEquation<double>();
+                parser.equation(real);
+            }
+            return true;
+            case 'z' : {
+                complex = DynamicLinearEquation<Complex<double>>();
+                parser.equation(complex);
+            }
+            return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Kopiuje i-ty uklad z pliku binarnego
+     * @param file
+     * @param i
+     */
+    void load(const BinaryFile& file, const size_t i) {
+        field = file.header().complex ? 'z' : 'r';
+        if (field == 'r')
+            file.load(i, real);
+        else
+            file.load(i, complex);
+    }
+
+    /**
+     * Zwraca uklad o skalarach T
+     * @return referencja na uklad
+     */
+    template <class T>
+    DynamicLinearEquation<T>& equation() {
+        if constexpr (std::is_same<T, double>::value)
+            return real;
+        else
+            return complex;
+    }
+
+    /**
+     * Zwraca liczbe niewiadomych
+     * @return rozmiar
+     */
+    size_t size() const {
+        return field == 'r' ? real.size() : complex.size();
+    }
+
+    /**
+     * Rozwiazuje uklad
+     */
+    void solve() {
+        if (field == 'r')
+            real.solve();
+        else
+            complex.solve();
+    }
+
+    /**
+     * Rozwiazuje uklad rozkladajac macierz na watkach puli
+     * @param pool
+     */
+    void solve(ThreadPool& pool) {
+        if (field == 'r')
+            real.solve(pool);
+        else
+            complex.solve(pool);
+    }
+};
+
+/**
+ * Wypisuje rozwiazanie ukladu rownan
+ * @tparam E
+ * @param equation
+ * @param out
+ */
+template <class E>
+void print_equation(const E& equation, Writer& out) {
+    out << "Macierz A^T:\n";
+    out << "Wektor wyrazow wolnych b:\n";
+
+    out << "Rozwiazanie x = (";
+    for (size_t i = 0; i < equation.size(); i++)
+        out << (i > 0 ? ", x" : "x") << i + 1;
+    out << "):\n";
+    out << equation.unknown_vector << '\n';
+
+    out << "Wektor bledu: Ax-b:\n";
+    out << equation.error_vector << '\n';
+}
+
+/**
+ * Wypisuje rozwiazanie ukladu poprzedzone nazwa ciala liczb
+ * @param system
+ * @param out
+ */
+void print_system(const System& system, Writer& out) {
+    ZAD3_PHASE(Phase::output, 0, 0);
+#ifdef ZAD3_INSTRUMENTATION
+    const size_t start = out.written();
+#endif
+
+    if (system.singular) {
+        out << (system.field == 'r' ? "Uklad rownan liniowych o wspolczynnikach rzeczywistych\n"
+                                    : "Uklad rownan liniowych o wspolczynnikach zespolonych\n");
+        out << "Macierz osobliwa, brak rozwiazania\n";
+    } else if (system.field == 'r') {
+        out << "Uklad rownan liniowych o wspolczynnikach rzeczywistych\n";
+        print_equation(system.real, out);
+    } else {
+        out << "Uklad rownan liniowych o wspolczynnikach zespolonych\n";
+        print_equation(system.complex, out);
+    }
+
+#ifdef ZAD3_INSTRUMENTATION
+    ZAD3_BYTES(out.written() - start);
+#endif
+}
+
+/**
+ * Wczytuje uklad jako macierz rzadka, rozwiazuje go iteracyjnie i wypisuje rozwiazanie jak print_system
+ * @tparam T
+ * @param parser
+ * @param title naglowek z nazwa ciala liczb
+ * @param out
+ */
+template <class T>
+void solve_sparse(Parser& parser, const char* title, Writer& out) {
+    SparseLinearEquation<T> equation;
+    parser.equation(equation);
+
+    const auto report = equation.solve();
+    if (!report.converged)
+        std::cerr << "Brak zbieznosci po " << report.iterations << " iteracjach, norma bledu " << report.residual << std::endl;
+
+    out << title;
+    print_equation(equation, out);
+}
+
+/**
+ * Wypisuje uklad rownan w formacie .dat (macierz A^T i wektor b) z precyzja pozwalajaca odtworzyc skalary
+ * @tparam T
+ * @param field
+ * @param equation
+ * @param out
+ */
+template <class T>
+void write_equation(const char field, const DynamicLinearEquation<T>& equation, Writer& out) {
+    out << field << '\n';
+
+    for (size_t y = 0; y < equation.size(); y++) {
+        for (size_t x = 0; x < equation.size(); x++)
+            out << (x > 0 ? " " : "") << equation.factor_matrix[x][y];
+        out << '\n';
+    }
+    out << equation.result_vector << '\n';
+}
+
+/**
+ * Przepisuje uklady z parsera do pliku binarnego, wszystkie musza miec to samo cialo i rozmiar co pierwszy
+ * @tparam T
+ * @param parser
+ * @param system pierwszy, juz wczytany uklad
+ * @param path
+ */
+template <class T>
+void write_binary(Parser& parser, System& system, const std::string& path) {
+    const char field = system.field;
+    BinaryWriter<T> writer(path, BinaryContent::systems, system.size());
+
+    while (true) {
+        writer.write(system.equation<T>());
+        if (parser.done())
+            break;
+        if (!system.read(parser) || system.field != field)
+            throw std::runtime_error("Mixed fields in input");
+    }
+    writer.close();
+}
+
+/**
+ * Konwertuje plik .dat do pliku binarnego lub odwrotnie (rodzaj pliku wejsciowego rozpoznawany po sygnaturze)
+ * @param input
+ * @param output
+ */
+void convert_file(const std::string& input, const std::string& output) {
+    MappedFile file(input);
+
+    if (BinaryFile::detect(file.data(), file.size())) {
+        const BinaryFile binary(std::move(file));
+        std::ofstream out(output);
+        {
+            Writer writer(out, std::numeric_limits<double>::max_digits10);
+            System system;
+            for (size_t i = 0; i < binary.count(); i++) {
+                system.load(binary, i);
+                if (system.field == 'r')
+                    write_equation(system.field, system.real, writer);
+                else
+                    write_equation(system.field, system.complex, writer);
+            }
+        }
+        if (!out)
+            throw std::runtime_error("Cannot write file " + output);
+        return;
+    }
+
+    Parser parser(file.data(), file.data() + file.size());
+    System system;
+    if (!system.read(parser))
+        throw std::runtime_error("Unrecognized field");
+
+    if (system.field == 'r')
+        write_binary<double>(parser, system, output);
+    else
+        write_binary<Complex<double>>(parser, system, output);
+}
+
+/**
+ * Rozwiazuje kolejno wszystkie uklady z pliku; plik jest mapowany w pamieci, uklady wczytywane
+ * sa oknami, kazde okno rozwiazywane na watkach puli i wypisywane w kolejnosci z pliku, a strony
+ * juz przeczytane zwalniane, wiec zuzycie pamieci nie zalezy od rozmiaru pliku
+ * @param path
+ * @param threads liczba watkow (0 - tyle, ile rdzeni)
+ * @param out
+ */
+void solve_batch_file(const std::string& path, const size_t threads, Writer& out) {
+    static const size_t window = 4096;
+
+    MappedFile file(path);
+    ThreadPool pool(threads);
+    Arena arena;
+    std::vector<DynamicLinearEquation<double>*> real;
+    std::vector<DynamicLinearEquation<Complex<double>>*> complex;
+    const std::unique_ptr<bool[]> real_failed(new bool[window]);
+    const std::unique_ptr<bool[]> complex_failed(new bool[window]);
+
+    /* male uklady tego samego rozmiaru rozwiazywane sa po kilka naraz (solve_lanes), osobno rzeczywiste i zespolone;
+     * uklad, ktorego nie da sie rozwiazac, wypisywany jest jako osobliwy, a pozostale rozwiazywane dalej (uklady
+     * z pliku sa kwadratowe, wiec jedynym bledem rozwiazania jest macierz osobliwa) */
+    const auto solve_window = [&](std::vector<System>& systems, const size_t count) {
+        real.clear();
+        complex.clear();
+        for (size_t i = 0; i < count; i++) {
+            if (systems[i].field == 'r')
+                real.push_back(&systems[i].real);
+            else
+                complex.push_back(&systems[i].complex);
+        }
+        solve_lanes(real.data(), real.size(), pool, 0, real_failed.get());
+        solve_lanes(complex.data(), complex.size(), pool, 0, complex_failed.get());
+        for (size_t i = 0, r = 0, z = 0; i < count; i++) {
+            systems[i].singular = systems[i].field == 'r' ? real_failed[r++] : complex_failed[z++];
+            print_system(systems[i], out);
+        }
+    };
+
+    /* uklady okna (macierze, wektory i pamiec robocza rozwiazania, takze na watkach puli) powstaja w arenie
+     * i sa niszczone przed jej wyczyszczeniem, wiec kolejne okna uzywaja tej samej pamieci zamiast
+     * alokowac i zwalniac kazdy wektor osobno */
+
+    /* plik binarny: rekordy kopiowane wprost do rownan, bez parsowania */
+    if (BinaryFile::detect(file.data(), file.size())) {
+        BinaryFile binary(std::move(file));
+        for (size_t from = 0; from < binary.count(); from += window) {
+            const size_t count = std::min(window, binary.count() - from);
+            {
+                const AllocationScope scope(&arena);
+                std::vector<System> systems(count);
+                for (size_t i = 0; i < count; i++)
+                    systems[i].load(binary, from + i);
+                binary.release(from + count);
+                solve_window(systems, count);
+            }
+            arena.reset();
+        }
+        return;
+    }
+
+    Parser parser(file.data(), file.data() + file.size());
+    bool recognized = true;
+
+    while (recognized && !parser.done()) {
+        {
+            const AllocationScope scope(&arena);
+            std::vector<System> systems(window);
+            size_t count = 0;
+            while (count < window && !parser.done()) {
+                recognized = systems[count].read(parser);
+                if (!recognized)
+                    break;
+                count++;
+            }
+            file.release(parser.position());
+            solve_window(systems, count);
+        }
+        arena.reset();
+    }
+
+    if (!recognized)
+        out << "Nie rozpoznane cialo liczb\n";
+}
 
 int main(int argc, char** argv) {
-    char field;
-    std::cin >> field;
+    /* wyniki wypisywane bez oprozniania bufora po kazdym wierszu, co przy wielu ukladach dominowaloby czas */
+    std::ios::sync_with_stdio(false);
 
-    switch (field) {
-        case 'r' : {
-            LinearEquation5d equation;
+#ifdef ZAD3_INSTRUMENTATION
+    Instrumentation::install();
+#endif
 
-            std::cout << "Uklad rownan liniowych o wspolczynnikach rzeczywistych" << std::endl;
-            std::cout << "Macierz A^T:" << std::endl;
+    /* bledy wejscia (ParseError), argumentow i plikow koncza program komunikatem zamiast przerwaniem */
+    try {
+        /* --precision p|shortest przed trybem ustawia precyzje wypisywanych rozwiazan (domyslnie jak operator<<),
+         * a nazwa programu przesuwana jest na miejsce zdjetej opcji */
+        int precision = Writer::default_precision;
+        if (argc > 2 && std::string(argv[1]) == "--precision") {
+            precision = std::string(argv[2]) == "shortest" ? Writer::shortest : std::stoi(argv[2]);
+            argv[2] = argv[0];
+            argc -= 2;
+            argv += 2;
+        }
 
-            std::cin >> equation.factor_matrix;
-            equation.factor_matrix = equation.factor_matrix.transpose();
+        const std::string mode = argc > 1 ? argv[1] : "";
 
-            std::cout << "Wektor wyrazow wolnych b:" << std::endl;
-            std::cin >> equation.result_vector;
+        if (mode == "--convert") {
+            if (argc != 4) {
+                std::cerr << "Uzycie: " << argv[0] << " --convert wejscie wyjscie" << std::endl;
+                return 1;
+            }
+            convert_file(argv[2], argv[3]);
+            return 0;
+        }
 
-            equation.solve();
+        if (mode == "--batch") {
+            const bool threads = argc == 5 && std::string(argv[3]) == "--threads";
+            if (argc != 3 && !threads) {
+                std::cerr << "Uzycie: " << argv[0] << " --batch plik [--threads n]" << std::endl;
+                return 1;
+            }
+            Writer out(std::cout, precision);
+            solve_batch_file(argv[2], threads ? std::stoul(argv[4]) : 1, out);
+            return 0;
+        }
 
-            std::cout << "Rozwiazanie x = (x1, x2, x3, x4, x5):" << std::endl;
-            std::cout << equation.unknown_vector << std::endl;
+        if (mode == "--server") {
+            std::string socket;
+            size_t workers = 0;
+            bool valid = argc % 2 == 0;
+            for (int i = 2; valid && i < argc; i += 2) {
+                const std::string option = argv[i];
+                if (option == "--socket")
+                    socket = argv[i + 1];
+                else if (option == "--threads")
+                    workers = std::stoul(argv[i + 1]);
+                else
+                    valid = false;
+            }
+            if (!valid) {
+                std::cerr << "Uzycie: " << argv[0] << " --server [--socket sciezka] [--threads n]" << std::endl;
+                return 1;
+            }
 
-            std::cout << "Wektor bledu: Ax-b:" << std::endl;
-            std::cout << equation.error_vector << std::endl;
+            /* bez gniazda zadania czytane sa ze standardowego wejscia, a odpowiedzi pisane na standardowe wyjscie */
+            Server server(workers);
+            if (socket.empty())
+                server.serve(STDIN_FILENO, STDOUT_FILENO);
+            else
+                server.listen(socket);
+            return 0;
         }
-        break;
-        case 'z' : {
-            LinearEquation5c equation;
 
-            std::cout << "Uklad rownan liniowych o wspolczynnikach zespolonych" << std::endl;
-            std::cout << "Macierz A^T:" << std::endl;
+        if (mode == "--sparse") {
+            if (argc != 2) {
+                std::cerr << "Uzycie: " << argv[0] << " --sparse < plik" << std::endl;
+                return 1;
+            }
 
-            std::cin >> equation.factor_matrix;
-            equation.factor_matrix = equation.factor_matrix.transpose();
+            const std::string input((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+            Parser parser(input);
+            Writer out(std::cout, precision);
+            switch (parser.field()) {
+                case 'r' :
+                    solve_sparse<double>(parser, "Uklad rownan liniowych o wspolczynnikach rzeczywistych\n", out);
+                    break;
+                case 'z' :
+                    solve_sparse<Complex<double>>(parser, "Uklad rownan liniowych o wspolczynnikach zespolonych\n", out);
+                    break;
+                default:
+                    out << "Nie rozpoznane cialo liczb\n";
+            }
+            return 0;
+        }
+
+        const bool threads = mode == "--threads";
+        if (argc > 1 && (!threads || argc != 3)) {
+            std::cerr << "Uzycie: " << argv[0] << " [--precision p|shortest] [--threads n] < plik" << std::endl;
+            return 1;
+        }
 
-            std::cout << "Wektor wyrazow wolnych b:" << std::endl;
-            std::cin >> equation.result_vector;
+        /* cale wejscie wczytywane naraz, skalary parsowane wprost z bufora */
+        const std::string input((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+        Parser parser(input);
 
-            equation.solve();
+        System system;
+        if (!system.read(parser)) {
+            std::cout << "Nie rozpoznane cialo liczb\n";
+            return 0;
+        }
 
-            std::cout << "Rozwiazanie x = (x1, x2, x3, x4, x5):" << std::endl;
-            std::cout << equation.unknown_vector << std::endl;
+        /* duzy uklad rozkladany na wszystkich rdzeniach, dla malego nie oplaca sie nawet uruchamiac watkow */
+        std::unique_ptr<ThreadPool> pool;
+        if (system.size() >= BlockedFactorization<Complex<double>>::threshold)
+            pool.reset(new ThreadPool(threads ? std::stoul(argv[2]) : 0));
 
-            std::cout << "Wektor bledu: Ax-b:" << std::endl;
-            std::cout << equation.error_vector << std::endl;
+        /* wczytany uklad jest kwadratowy, wiec rozwiazanie konczy sie bledem tylko dla macierzy osobliwej */
+        try {
+            if (pool)
+                system.solve(*pool);
+            else
+                system.solve();
+        } catch (const std::runtime_error&) {
+            system.singular = true;
         }
-        break;
-        default:
-            std::cout << "Nie rozpoznane cialo liczb" << std::endl;
+        Writer out(std::cout, precision);
+        print_system(system, out);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
     }
 }
@@ -0,0 +1,281 @@
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../inc/Kernels.hh"
+
+/* porownanie jader wszystkich zestawow instrukcji dostepnych w procesorze (Kernels::variant) z wersja ogolna:
+ * dot, axpy, matvec i gemm_subtract z Kernels<long double> z dopuszczalnym bledem zaokraglen zaleznym od
+ * dlugosci, a lane_solve i lane_residual (takze zespolone) z tym samym jadrem o szerokosci jednego skalara
+ * bit w bit (nie uzywaja fma); dlugosci sa nieparzyste i nie sa wielokrotnosciami szerokosci wektora,
+ * zeby sprawdzic obsluge reszty */
+
+using Reference = Kernels<long double>;
+
+static size_t failures = 0; /** Liczba niezgodnosci */
+
+/**
+ * Zglasza niezgodnosc wyniku jadra
+ * @param isa
+ * @param kernel
+ * @param length
+ * @param got
+ * @param expected
+ */
+static void fail(const char* isa, const char* kernel, const size_t length, const long double got, const long double expected) {
+    if (failures++ < 20)
+        std::cerr << std::setprecision(std::numeric_limits<long double>::max_digits10)
+                  << isa << ' ' << kernel << " n=" << length << ": " << static_cast<double>(got)
+                  << " zamiast " << static_cast<double>(expected) << std::endl;
+}
+
+/**
+ * Sprawdza wynik z dokladnoscia do bledu zaokraglen sumy terms skladnikow o sumie modulow magnitude
+ * @tparam T
+ * @param got
+ * @param expected
+ * @param terms
+ * @param magnitude
+ * @return czy wynik jest poprawny
+ */
+template <class T>
+static bool close(const T got, const long double expected, const size_t terms, const long double magnitude) {
+    const long double epsilon = std::numeric_limits<T>::epsilon();
+    return std::fabs(got - expected) <= 2 * (terms + 1) * epsilon * magnitude + std::numeric_limits<T>::min();
+}
+
+/**
+ * Testy jader dla skalarow T (double lub float)
+ * @tparam T
+ */
+template <class T>
+struct KernelTest {
+    static constexpr size_t lanes = KernelTable<T>::lanes;
+
+    std::mt19937_64 generator{20240611};
+
+    /**
+     * Losuje wektor o skladowych z przedzialu [-1, 1]
+     * @param n
+     * @return wektor
+     */
+    std::vector<T> random(const size_t n) {
+        std::uniform_real_distribution<T> distribution(-1, 1);
+        std::vector<T> result(n);
+        for (T& value : result)
+            value = distribution(generator);
+        return result;
+    }
+
+    /**
+     * Zamienia wektor na long double dla wersji ogolnej
+     * @param vector
+     * @return kopia
+     */
+    static std::vector<long double> extend(const std::vector<T>& vector) {
+        return std::vector<long double>(vector.begin(), vector.end());
+    }
+
+    void dot(const KernelTable<T>& table, const char* isa) {
+        for (size_t n = 0; n <= 67; n += n < 20 ? 1 : 7) {
+            const std::vector<T> a = random(n), b = random(n);
+            long double magnitude = 0;
+            for (size_t i = 0; i < n; i++)
+                magnitude += std::fabs(static_cast<long double>(a[i]) * b[i]);
+            const long double expected = Reference::dot(extend(a).data(), extend(b).data(), n);
+            const T got = table.dot(a.data(), b.data(), n);
+            if (!close(got, expected, n, magnitude))
+                fail(isa, "dot", n, got, expected);
+        }
+    }
+
+    void axpy(const KernelTable<T>& table, const char* isa) {
+        for (size_t n = 0; n <= 67; n += n < 20 ? 1 : 7) {
+            const T alpha = random(1)[0];
+            const std::vector<T> x = random(n);
+            std::vector<T> y = random(n);
+            std::vector<long double> expected = extend(y);
+            Reference::axpy(alpha, extend(x).data(), expected.data(), n);
+            const std::vector<T> original = y;
+            table.axpy(alpha, x.data(), y.data(), n);
+            for (size_t i = 0; i < n; i++) {
+                if (!close(y[i], expected[i], 1, std::fabs(original[i]) + std::fabs(static_cast<long double>(alpha) * x[i]))) {
+                    fail(isa, "axpy", n, y[i], expected[i]);
+                    break;
+                }
+            }
+        }
+    }
+
+    void matvec(const KernelTable<T>& table, const char* isa) {
+        for (size_t rows = 1; rows <= 9; rows += 4) {
+            for (size_t columns = 1; columns <= 41; columns += 4) {
+                const size_t stride = columns + 3;
+                const std::vector<T> matrix = random(rows * stride), x = random(columns);
+                std::vector<T> y(rows);
+                std::vector<long double> expected(rows);
+                Reference::matvec(extend(matrix).data(), stride, extend(x).data(), expected.data(), rows, columns);
+                table.matvec(matrix.data(), stride, x.data(), y.data(), rows, columns);
+                for (size_t r = 0; r < rows; r++) {
+                    long double magnitude = 0;
+                    for (size_t c = 0; c < columns; c++)
+                        magnitude += std::fabs(static_cast<long double>(matrix[r * stride + c]) * x[c]);
+                    if (!close(y[r], expected[r], columns, magnitude)) {
+                        fail(isa, "matvec", columns, y[r], expected[r]);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    void gemm_subtract(const KernelTable<T>& table, const char* isa) {
+        for (size_t rows = 1; rows <= 7; rows += 3) {
+            for (size_t columns = 1; columns <= 37; columns += 6) {
+                for (size_t depth = 1; depth <= 13; depth += 4) {
+                    const size_t a_stride = depth + 1, b_stride = columns + 2, c_stride = columns + 5;
+                    const std::vector<T> a = random(rows * a_stride), b = random(depth * b_stride);
+                    std::vector<T> c = random(rows * c_stride);
+                    std::vector<long double> expected = extend(c);
+                    Reference::gemm_subtract(extend(a).data(), a_stride, extend(b).data(), b_stride, expected.data(), c_stride,
+                                             rows, columns, depth);
+                    const std::vector<T> original = c;
+                    table.gemm_subtract(a.data(), a_stride, b.data(), b_stride, c.data(), c_stride, rows, columns, depth);
+
+                    bool correct = true;
+                    for (size_t i = 0; correct && i < rows; i++) {
+                        for (size_t j = 0; correct && j < c_stride; j++) {
+                            const size_t index = i * c_stride + j;
+                            long double magnitude = std::fabs(static_cast<long double>(original[index]));
+                            for (size_t p = 0; j < columns && p < depth; p++)
+                                magnitude += std::fabs(static_cast<long double>(a[i * a_stride + p]) * b[p * b_stride + j]);
+                            /* kolumny poza columns (odstep stride) nie moga sie zmienic */
+                            correct = close(c[index], expected[index], depth, magnitude);
+                            if (!correct)
+                                fail(isa, "gemm_subtract", depth, c[index], expected[index]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Losuje lanes ukladow o rozmiarze n zapisanych naprzemiennie; czesc ukladow jest osobliwa (dwa takie
+     * same wiersze lub zerowa kolumna), a jeden ma macierz jednostkowa
+     * @param n
+     * @return uklady
+     */
+    std::vector<T> systems(const size_t n) {
+        std::vector<T> system = random(n * (n + 1) * lanes);
+        const auto at = [&](const size_t x, const size_t y, const size_t l) -> T& {
+            return system[(x * (n + 1) + y) * lanes + l];
+        };
+        for (size_t x = 0; x < n; x++) {
+            for (size_t y = 0; y < n; y++) {
+                at(x, y, 1) = x == y;
+                at(x, y, 2) = n > 1 && x == 1 ? at(0, y, 2) : at(x, y, 2);
+                at(x, y, lanes - 1) = y == n / 2 ? 0 : at(x, y, lanes - 1);
+            }
+        }
+        return system;
+    }
+
+    /**
+     * Porownuje rozwiazania lub elementy glowne ukladow nieosobliwych bit w bit i zglasza pierwsza roznice
+     * @param isa
+     * @param kernel
+     * @param n
+     * @param got
+     * @param expected
+     * @param singular maska ukladow osobliwych
+     */
+    static void compare(const char* isa, const char* kernel, const size_t n, const std::vector<T>& got, const std::vector<T>& expected,
+                        const unsigned singular) {
+        for (size_t i = 0; i < got.size(); i++) {
+            if (!((singular >> (i % lanes)) & 1) && std::memcmp(&got[i], &expected[i], sizeof(T)) != 0) {
+                fail(isa, kernel, n, got[i], expected[i]);
+                return;
+            }
+        }
+    }
+
+    void lane_solve(const KernelTable<T>& table, const char* isa) {
+        for (size_t n = 1; n <= lane_solver_limit; n++) {
+            const std::vector<T> system = systems(n);
+            std::vector<T> solution(n * lanes), pivots((n + 1) * lanes), error(n * lanes);
+            std::vector<T> expected_solution(n * lanes), expected_pivots((n + 1) * lanes), expected_error(n * lanes);
+
+            const unsigned expected = SimdKernels<ScalarSimd<T>>::lane_solve(system.data(), n, expected_solution.data(),
+                                                                            expected_pivots.data());
+            const unsigned singular = table.lane_solve(system.data(), n, solution.data(), pivots.data());
+            if (singular != expected)
+                fail(isa, "lane_solve (maska osobliwych)", n, singular, expected);
+            compare(isa, "lane_solve (rozwiazanie)", n, solution, expected_solution, expected);
+            compare(isa, "lane_solve (elementy glowne)", n, pivots, expected_pivots, expected);
+
+            /* blad liczony z tego samego rozwiazania (wzorcowego), zeby porownac samo jadro lane_residual */
+            SimdKernels<ScalarSimd<T>>::lane_residual(system.data(), n, expected_solution.data(), expected_error.data());
+            table.lane_residual(system.data(), n, expected_solution.data(), error.data());
+            compare(isa, "lane_residual", n, error, expected_error, expected);
+        }
+    }
+
+    void complex_lane_solve(const KernelTable<T>& table, const char* isa) {
+        for (size_t n = 1; n <= lane_solver_limit; n++) {
+            const std::vector<T> real = systems(n), imaginary = systems(n);
+            std::vector<T> solution_real(n * lanes), solution_imaginary(n * lanes), pivots((n + 1) * lanes);
+            std::vector<T> expected_real(n * lanes), expected_imaginary(n * lanes), expected_pivots((n + 1) * lanes);
+
+            const unsigned expected = SimdKernels<ScalarSimd<T>>::complex_lane_solve(real.data(), imaginary.data(), n,
+                                                                                    expected_real.data(), expected_imaginary.data(),
+                                                                                    expected_pivots.data());
+            const unsigned singular = table.complex_lane_solve(real.data(), imaginary.data(), n, solution_real.data(),
+                                                               solution_imaginary.data(), pivots.data());
+            if (singular != expected)
+                fail(isa, "complex_lane_solve (maska osobliwych)", n, singular, expected);
+            compare(isa, "complex_lane_solve (rozwiazanie re)", n, solution_real, expected_real, expected);
+            compare(isa, "complex_lane_solve (rozwiazanie im)", n, solution_imaginary, expected_imaginary, expected);
+            compare(isa, "complex_lane_solve (elementy glowne)", n, pivots, expected_pivots, expected);
+
+            std::vector<T> error_real(n * lanes), error_imaginary(n * lanes);
+            std::vector<T> expected_error_real(n * lanes), expected_error_imaginary(n * lanes);
+            SimdKernels<ScalarSimd<T>>::complex_lane_residual(real.data(), imaginary.data(), n, expected_real.data(),
+                                                             expected_imaginary.data(), expected_error_real.data(),
+                                                             expected_error_imaginary.data());
+            table.complex_lane_residual(real.data(), imaginary.data(), n, expected_real.data(), expected_imaginary.data(),
+                                        error_real.data(), error_imaginary.data());
+            compare(isa, "complex_lane_residual (re)", n, error_real, expected_error_real, expected);
+            compare(isa, "complex_lane_residual (im)", n, error_imaginary, expected_error_imaginary, expected);
+        }
+    }
+
+    /**
+     * Sprawdza wszystkie warianty jader
+     */
+    void run() {
+        for (size_t i = 0; i < Kernels<T>::variants(); i++) {
+            const char* isa = nullptr;
+            const KernelTable<T> table = Kernels<T>::variant(i, isa);
+            const size_t before = failures;
+            dot(table, isa);
+            axpy(table, isa);
+            matvec(table, isa);
+            gemm_subtract(table, isa);
+            lane_solve(table, isa);
+            complex_lane_solve(table, isa);
+            std::cout << isa << " (" << (sizeof(T) == sizeof(double) ? "double" : "float") << "): "
+                      << (failures == before ? "ok" : "bledy") << '\n';
+        }
+    }
+};
+
+int main() {
+    KernelTest<double>().run();
+    KernelTest<float>().run();
+    return failures == 0 ? 0 : 1;
+}
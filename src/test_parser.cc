@@ -0,0 +1,114 @@
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+#include "../inc/LinearEquation.hh"
+#include "../inc/Parser.hh"
+
+/* parser formatu .dat: poprawne uklady (takze bez konca wiersza na koncu, z jawnym znakiem + i bialymi
+ * znakami wewnatrz liczby zespolonej) wczytuja sie do oczekiwanych skalarow, a niepoprawne liczby, np. 2x
+ * czy (1+-2i), koncza sie ParseError, a nie obcieciem liczby */
+
+static size_t failures = 0; /** Liczba niezgodnosci */
+
+/**
+ * Zglasza niezgodnosc
+ * @param input
+ * @param message
+ */
+static void fail(const std::string& input, const std::string& message) {
+    if (failures++ < 20)
+        std::cerr << '"' << input << "\": " << message << std::endl;
+}
+
+/**
+ * Porownuje skalary
+ * @param a
+ * @param b
+ * @return czy sa rowne
+ */
+static bool same(const double a, const double b) {
+    return a == b;
+}
+
+static bool same(const Complex<double>& a, const Complex<double>& b) {
+    return a.real == b.real && a.imaginary == b.imaginary;
+}
+
+/**
+ * Wczytuje uklad o skalarach T (bez znaku ciala), jak main dla jednego ukladu - bez sprawdzania, co jest dalej
+ * @tparam T
+ * @param input
+ * @return uklad
+ */
+template <class T>
+static DynamicLinearEquation<T> parse(const std::string& input) {
+    Parser parser(input);
+    DynamicLinearEquation<T> equation;
+    parser.equation(equation);
+    return equation;
+}
+
+/**
+ * Sprawdza, ze uklad wczytuje sie do macierzy (zapisanej kolumnami jak w pliku) i wektora expected
+ * @tparam T
+ * @param input
+ * @param expected skalary w kolejnosci z pliku
+ */
+template <class T>
+static void accept(const std::string& input, const std::initializer_list<T> expected) {
+    try {
+        const DynamicLinearEquation<T> equation = parse<T>(input);
+        const size_t n = equation.size();
+        if (expected.size() != n * (n + 1)) {
+            fail(input, "zly rozmiar ukladu");
+            return;
+        }
+        const T* value = expected.begin();
+        for (size_t y = 0; y < n; y++)
+            for (size_t x = 0; x < n; x++, value++)
+                if (!same(equation.factor_matrix[x][y], *value))
+                    fail(input, "zly skalar macierzy");
+        for (size_t x = 0; x < n; x++, value++)
+            if (!same(equation.result_vector[x], *value))
+                fail(input, "zly skalar wektora");
+    } catch (const ParseError& e) {
+        fail(input, e.what());
+    }
+}
+
+/**
+ * Sprawdza, ze wczytanie ukladu konczy sie ParseError
+ * @tparam T
+ * @param input
+ */
+template <class T>
+static void reject(const std::string& input) {
+    try {
+        parse<T>(input);
+        fail(input, "wczytany mimo bledu");
+    } catch (const ParseError&) {}
+}
+
+int main() {
+    accept<double>("1 2\n3 4\n5 6\n", {1, 2, 3, 4, 5, 6});
+    accept<double>("1\t-2\r\n+3 4e1\n5 .5", {1, -2, 3, 40, 5, 0.5});
+    accept<Complex<double>>("(1+2i) (3-4i)\n( 5 - 6i ) (+7+8i)\n(9+0i) (0-1i)",
+                            {Complex<double>(1, 2), Complex<double>(3, -4), Complex<double>(5, -6), Complex<double>(7, 8),
+                             Complex<double>(9, 0), Complex<double>(0, -1)});
+
+    /* kazdy z ponizszych ukladow wczytywal sie wczesniej: liczba konczyla sie na pierwszym znaku, ktory do niej
+     * nie pasowal, a reszta byla kolejna liczba albo zostawala nieprzeczytana za ostatnim skalarem */
+    reject<double>("1\n2x");
+    reject<double>("1 2\n3 4\n5 6x\n");
+    reject<double>("1 2\n3+4\n5 6\n");
+    reject<double>("1 2\n3 4\n5 6.5.1\n");
+    reject<Complex<double>>("(1+-2i)\n(3+0i)\n");
+    reject<Complex<double>>("(1++2i)\n(3+0i)\n");
+    reject<Complex<double>>("(1- -2i)\n(3+0i)\n");
+    reject<Complex<double>>("(1+2i)\n(3+0i)x\n");
+    reject<Complex<double>>("(1+2i)\n(3+0i)(4+0i)\n");
+
+    std::cout << (failures == 0 ? "ok" : "bledy") << '\n';
+    return failures == 0 ? 0 : 1;
+}
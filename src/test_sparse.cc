@@ -0,0 +1,99 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "../inc/LinearEquation.hh"
+
+/* rozwiazania SparseLinearEquation porownywane z rozwiazaniami dokladnymi: macierze z uwarunkowaniem ILU(0)
+ * (trojdiagonalna z przewazajaca przekatna) i macierze z zerami na przekatnej, dla ktorych rozklad ILU(0) jest
+ * niemozliwy i metody dzialaja bez uwarunkowania (permutacje i macierz bez zadnego elementu na przekatnej);
+ * rozmiary sa mniejsze od IterativeCriteria::restart, bo bez uwarunkowania GMRES z restartem nie zbiega dla
+ * dluzszych permutacji cyklicznych */
+
+static size_t failures = 0; /** Liczba niezgodnosci */
+
+/**
+ * Zglasza niezgodnosc rozwiazania
+ * @param what
+ * @param n
+ * @param message
+ */
+static void fail(const char* what, const size_t n, const char* message) {
+    if (failures++ < 20)
+        std::cerr << what << " n=" << n << ": " << message << std::endl;
+}
+
+/**
+ * Rozwiazuje uklad o macierzy z elementow (x, y, wartosc) i rozwiazaniu dokladnym expected
+ * i sprawdza zbieznosc oraz odleglosc od rozwiazania dokladnego
+ * @tparam T
+ * @param what
+ * @param n
+ * @param entries
+ * @param expected
+ */
+template <class T>
+static void check(const char* what, const size_t n, const std::vector<std::pair<std::pair<size_t, size_t>, T>>& entries,
+                  const std::vector<T>& expected) {
+    SparseBuilder<T> builder(n, n);
+    for (const auto& entry : entries)
+        builder.add(entry.first.first, entry.first.second, entry.second);
+
+    SparseLinearEquation<T> equation;
+    equation.factor_matrix = builder.build();
+    DynamicVector<T> solution(n);
+    for (size_t i = 0; i < n; i++)
+        solution[i] = expected[i];
+    equation.result_vector = equation.factor_matrix * solution;
+
+    const auto report = equation.solve();
+    if (!report.converged) {
+        fail(what, n, "brak zbieznosci");
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!(Scalar<T>::magnitude(equation.unknown_vector[i] - expected[i]) <= 1e-6)) {
+            fail(what, n, "rozwiazanie rozni sie od dokladnego");
+            return;
+        }
+    }
+}
+
+/**
+ * Sprawdza uklady o skalarach T
+ * @tparam T
+ * @param unit jednostka skalarow (1 lub liczba zespolona)
+ */
+template <class T>
+static void run(const T unit) {
+    using Entries = std::vector<std::pair<std::pair<size_t, size_t>, T>>;
+
+    /* macierz permutacji z wejscia "r 0 1 1 0 1 2" */
+    check<T>("permutacja 2x2", 2, Entries{{{0, 1}, unit}, {{1, 0}, unit}}, {T(2) * unit, unit});
+
+    for (const size_t n : {3, 7, 20}) {
+        Entries cycle, hollow, tridiagonal;
+        std::vector<T> expected(n);
+        for (size_t x = 0; x < n; x++) {
+            expected[x] = T(static_cast<double>(x) - 1.5) * unit;
+            cycle.push_back({{x, (x + 1) % n}, unit});
+            hollow.push_back({{x, (x + 1) % n}, T(4) * unit});
+            hollow.push_back({{x, (x + 2) % n}, unit});
+            tridiagonal.push_back({{x, x}, T(4) * unit});
+            if (x > 0)
+                tridiagonal.push_back({{x, x - 1}, T(-1)});
+            if (x + 1 < n)
+                tridiagonal.push_back({{x, x + 1}, T(-1) * unit});
+        }
+        check<T>("permutacja cykliczna", n, cycle, expected);
+        check<T>("zera na przekatnej", n, hollow, expected);
+        check<T>("trojdiagonalna (ILU)", n, tridiagonal, expected);
+    }
+}
+
+int main() {
+    run<double>(1);
+    run<Complex<double>>(Complex<double>(0.6, 0.8));
+    std::cout << (failures == 0 ? "ok" : "bledy") << '\n';
+    return failures == 0 ? 0 : 1;
+}
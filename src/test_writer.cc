@@ -0,0 +1,157 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../inc/Writer.hh"
+
+/* porownanie tekstu z Writer z tekstem operator<< na strumieniu z ta sama precyzja, bajt w bajt: skalary
+ * double i float (takze +-0, +-inf, nan, liczby podnormalne i skrajne wykladniki), liczby zespolone i wektory,
+ * z duzym buforem i z buforem 7 bajtow, ktory zapelnia sie w trakcie zapisu jednej liczby; w trybie
+ * shortest sprawdzane jest, ze zapis wczytuje sie z powrotem jako ta sama liczba */
+
+static size_t failures = 0; /** Liczba niezgodnosci */
+
+/**
+ * Zglasza niezgodnosc tekstu
+ * @param what
+ * @param precision
+ * @param capacity
+ * @param got
+ * @param expected
+ */
+static void fail(const char* what, const int precision, const size_t capacity, const std::string& got, const std::string& expected) {
+    if (failures++ < 20)
+        std::cerr << what << " (precyzja " << precision << ", bufor " << capacity << "): \"" << got
+                  << "\" zamiast \"" << expected << '"' << std::endl;
+}
+
+/**
+ * Wartosci szczegolne typu T
+ * @tparam T
+ * @return wartosci
+ */
+template <class T>
+static std::vector<T> special() {
+    using limits = std::numeric_limits<T>;
+    return {T(0), -T(0), limits::infinity(), -limits::infinity(), limits::quiet_NaN(), -limits::quiet_NaN(),
+            limits::min(), -limits::min(), limits::denorm_min(), -limits::denorm_min(), limits::min() / 3,
+            limits::max(), -limits::max(), limits::lowest(), limits::epsilon(), T(1), T(-1), T(0.1), T(0.5), T(9.5),
+            T(99999.95), T(999999.5), T(1e6), T(123456789), T(1e-5), T(0.0001), T(1) / T(3), T(2) / T(3)};
+}
+
+/**
+ * Losuje wartosci T o dowolnym wzorze bitow (a wiec z calego zakresu wykladnikow)
+ * @tparam T
+ * @tparam U typ calkowity o rozmiarze T
+ * @param generator
+ * @param count
+ * @return wartosci
+ */
+template <class T, class U>
+static std::vector<T> random(std::mt19937_64& generator, const size_t count) {
+    std::vector<T> result(count);
+    for (T& value : result) {
+        const U bits = static_cast<U>(generator());
+        std::memcpy(&value, &bits, sizeof(T));
+    }
+    return result;
+}
+
+/**
+ * Porownuje zapis wartosci przez Writer i przez operator<<
+ * @tparam V
+ * @param what
+ * @param values
+ * @param precision
+ * @param capacity
+ */
+template <class V>
+static void compare(const char* what, const std::vector<V>& values, const int precision, const size_t capacity) {
+    for (const V& value : values) {
+        std::ostringstream expected;
+        expected << std::setprecision(precision) << value << ' ' << value << '\n';
+
+        std::ostringstream got;
+        {
+            Writer writer(got, precision, capacity);
+            writer << value << ' ' << value << '\n';
+        }
+        if (got.str() != expected.str())
+            fail(what, precision, capacity, got.str(), expected.str());
+    }
+}
+
+/**
+ * Sprawdza, ze najkrotszy zapis wczytuje sie jako ta sama liczba
+ * @tparam T
+ * @param what
+ * @param values
+ * @param capacity
+ */
+template <class T>
+static void round_trip(const char* what, const std::vector<T>& values, const size_t capacity) {
+    for (const T value : values) {
+        if (value != value)
+            continue;
+        std::ostringstream got;
+        {
+            Writer writer(got, Writer::shortest, capacity);
+            writer << value;
+        }
+        T parsed;
+        if constexpr (sizeof(T) == sizeof(float))
+            parsed = std::strtof(got.str().c_str(), nullptr);
+        else
+            parsed = std::strtod(got.str().c_str(), nullptr);
+        if (std::memcmp(&parsed, &value, sizeof(T)) != 0) {
+            std::ostringstream expected;
+            expected << std::setprecision(std::numeric_limits<T>::max_digits10) << value;
+            fail(what, Writer::shortest, capacity, got.str(), expected.str());
+        }
+    }
+}
+
+int main() {
+    std::mt19937_64 generator(20240611);
+    std::vector<double> doubles = special<double>();
+    std::vector<float> floats = special<float>();
+    for (const double value : random<double, uint64_t>(generator, 4000))
+        doubles.push_back(value);
+    for (const float value : random<float, uint32_t>(generator, 4000))
+        floats.push_back(value);
+
+    std::vector<Complex<double>> complexes;
+    for (size_t i = 0; i + 1 < doubles.size(); i += 2)
+        complexes.emplace_back(doubles[i], doubles[i + 1]);
+    for (size_t i = 0; i < 8; i++)
+        complexes.emplace_back(doubles[i], doubles[(i + 3) % 8]);
+
+    std::vector<DynamicVector<double>> vectors;
+    for (size_t n = 0; n < 5; n++) {
+        DynamicVector<double> vector(n);
+        for (size_t i = 0; i < n; i++)
+            vector[i] = doubles[(7 * n + i) % doubles.size()];
+        vectors.push_back(vector);
+    }
+
+    for (const size_t capacity : {size_t(7), Writer::default_capacity}) {
+        for (const int precision : {Writer::default_precision, 0, 1, 2, 3, 10, 15, 17, 25}) {
+            compare("double", doubles, precision, capacity);
+            compare("float", floats, precision, capacity);
+            compare("Complex<double>", complexes, precision, capacity);
+            compare("DynamicVector<double>", vectors, precision, capacity);
+        }
+        round_trip("double", doubles, capacity);
+        round_trip("float", floats, capacity);
+    }
+
+    std::cout << (failures == 0 ? "ok" : "bledy") << '\n';
+    return failures == 0 ? 0 : 1;
+}